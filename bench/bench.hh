@@ -0,0 +1,83 @@
+#ifndef HAN_BENCH_HH
+#define HAN_BENCH_HH
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+    template <typename T>
+    inline auto do_not_optimize(const T& value) -> void {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline auto clobber() -> void {
+        asm volatile("" : : : "memory");
+    }
+
+    struct stats {
+        double min = 0;
+        double median = 0;
+        double p90 = 0;
+        double p99 = 0;
+    };
+
+    inline auto percentile(const std::vector<double>& sorted, double p) -> double {
+        auto rank = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    template <typename F>
+    auto measure_stats(F&& body, std::size_t ops, int repetitions = 15, int warmup = 1) -> stats {
+        using clock = std::chrono::steady_clock;
+        for (auto i = 0; i < warmup; ++i) body();
+        auto samples = std::vector<double>{};
+        samples.reserve(static_cast<std::size_t>(std::max(repetitions, 1)));
+        for (auto i = 0; i < std::max(repetitions, 1); ++i) {
+            auto start = clock::now();
+            body();
+            auto stop = clock::now();
+            auto ns = std::chrono::duration<double, std::nano>(stop - start).count();
+            samples.push_back(ns / static_cast<double>(ops));
+        }
+        std::sort(samples.begin(), samples.end());
+        return {samples.front(), percentile(samples, 0.5), percentile(samples, 0.9), percentile(samples, 0.99)};
+    }
+
+    template <typename F>
+    auto measure(F&& body, std::size_t ops, int repetitions = 15) -> double {
+        return measure_stats(std::forward<F>(body), ops, repetitions).median;
+    }
+
+    inline auto report(const char* name, double ns_per_op) -> void {
+        std::printf("%-48s %10.3f ns/op\n", name, ns_per_op);
+    }
+
+    class json_report {
+        std::vector<std::string> entries;
+
+    public:
+        auto add(const std::string& name, const std::vector<std::pair<std::string, std::string>>& params,
+                 const stats& result) -> void {
+            auto entry = "{\"name\": \"" + name + "\"";
+            for (const auto& [key, value] : params) entry += ", \"" + key + "\": " + value;
+            char numbers[160];
+            std::snprintf(numbers, sizeof numbers,
+                          ", \"min_ns\": %.4f, \"median_ns\": %.4f, \"p90_ns\": %.4f, \"p99_ns\": %.4f}",
+                          result.min, result.median, result.p90, result.p99);
+            entries.push_back(entry + numbers);
+        }
+
+        auto write(std::FILE* out) const -> void {
+            std::fprintf(out, "{\"benchmarks\": [\n");
+            for (std::size_t i = 0; i < entries.size(); ++i)
+                std::fprintf(out, "  %s%s\n", entries[i].c_str(), i + 1 == entries.size() ? "" : ",");
+            std::fprintf(out, "]}\n");
+        }
+    };
+}
+
+#endif
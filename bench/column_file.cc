@@ -0,0 +1,72 @@
+#include "bench.hh"
+#include <han/column_file.hh>
+#include <han/views.hh>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    constexpr auto rows = std::size_t{1} << 22;
+
+    // What a job does without the mapped format: read the whole column and
+    // rebuild a std::vector<maybe<double>> before the first query.
+    auto load(const char* path) -> std::vector<han::maybe<double>> {
+        auto file = std::fopen(path, "rb");
+        auto header = han::column_header{};
+        std::fread(&header, sizeof header, 1, file);
+        auto validity = std::vector<std::uint64_t>((header.rows + 63) / 64);
+        std::fseek(file, static_cast<long>(header.validity), SEEK_SET);
+        std::fread(validity.data(), sizeof(std::uint64_t), validity.size(), file);
+        auto values = std::vector<double>(header.rows);
+        std::fseek(file, static_cast<long>(header.values), SEEK_SET);
+        std::fread(values.data(), sizeof(double), values.size(), file);
+        std::fclose(file);
+
+        auto out = std::vector<han::maybe<double>>{};
+        out.reserve(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if ((validity[i / 64] >> (i % 64)) & 1) out.push_back(han::maybe{values[i]});
+            else out.push_back(std::nullopt);
+        }
+        return out;
+    }
+}
+
+auto main() -> int {
+    auto path = "/tmp/han-bench-column-" + std::to_string(::getpid()) + ".bin";
+    auto random = std::mt19937{42};
+    auto coin = std::bernoulli_distribution{0.7};
+    auto column = han::maybe_vector<double>{};
+    column.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (coin(random)) column.push_back(static_cast<double>(i % 1000));
+        else column.push_back(std::nullopt);
+    }
+    han::write_column(path.c_str(), column);
+
+    bench::report("startup, read into vector<maybe<double>>", bench::measure([&] {
+        auto loaded = load(path.c_str());
+        bench::do_not_optimize(loaded.data());
+    }, 1, 5));
+    bench::report("startup, mapped_column::open", bench::measure([&] {
+        auto mapped = han::mapped_column<double>::open(path.c_str());
+        bench::do_not_optimize(mapped);
+    }, 1, 5));
+
+    auto loaded = load(path.c_str());
+    auto mapped = han::mapped_column<double>::open(path.c_str()).or_else(han::mapped_column<double>{});
+    bench::report("scan, vector<maybe<double>>", bench::measure([&] {
+        auto sum = 0.0;
+        for (auto x : loaded | han::views::present) sum += x;
+        bench::do_not_optimize(sum);
+    }, rows, 5));
+    bench::report("scan, mapped_column<double>", bench::measure([&] {
+        auto sum = 0.0;
+        for (auto x : mapped | han::views::present) sum += x;
+        bench::do_not_optimize(sum);
+    }, rows, 5));
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "bench.hh"
+#include <han/columns.hh>
+#include <random>
+
+namespace {
+    constexpr auto size = std::size_t{1} << 20;
+
+    auto name(han::columns::isa level) -> const char* {
+        switch (level) {
+        case han::columns::isa::scalar: return "scalar";
+        case han::columns::isa::sse2: return "sse2";
+        case han::columns::isa::avx2: return "avx2";
+        case han::columns::isa::avx512: return "avx512";
+        }
+        return "?";
+    }
+
+    auto run(double ratio) -> void {
+        auto random = std::mt19937{42};
+        auto coin = std::bernoulli_distribution{ratio};
+        auto rows = std::vector<han::maybe<float>>{};
+        auto column = han::maybe_vector<float>{};
+        column.reserve(size);
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            auto value = static_cast<float>(i % 1000);
+            if (coin(random)) {
+                rows.push_back(han::maybe{value});
+                column.push_back(value);
+            } else {
+                rows.push_back(std::nullopt);
+                column.push_back(std::nullopt);
+            }
+        }
+        auto times = [](float x) { return x * 1.0001f; };
+        auto small = [](float x) { return x < 500.0f; };
+        char label[64];
+
+        std::printf("present ratio %.2f\n", ratio);
+        auto out = std::vector<han::maybe<float>>{};
+        out.reserve(size);
+        bench::report("transform, vector<maybe>::then_do()", bench::measure([&] {
+            out.clear();
+            for (const auto& x : rows) out.push_back(x.then_do(times));
+            bench::do_not_optimize(out.data());
+        }, size));
+        for (auto level : {han::columns::isa::scalar, han::columns::isa::sse2,
+                           han::columns::isa::avx2, han::columns::isa::avx512}) {
+            if (!han::columns::supported(level)) continue;
+            std::snprintf(label, sizeof label, "transform, columns %s", name(level));
+            bench::report(label, bench::measure([&] {
+                han::columns::transform(column, times, level);
+                bench::do_not_optimize(column.data());
+            }, size));
+        }
+
+        bench::report("filter, vector<maybe>::then_maybe()", bench::measure([&] {
+            out.clear();
+            for (const auto& x : rows) {
+                out.push_back(x.then_maybe([&](float y) {
+                    return small(y) ? han::maybe{y} : han::maybe<float>{};
+                }));
+            }
+            bench::do_not_optimize(out.data());
+        }, size));
+        for (auto level : {han::columns::isa::scalar, han::columns::isa::sse2,
+                           han::columns::isa::avx2, han::columns::isa::avx512}) {
+            if (!han::columns::supported(level)) continue;
+            std::snprintf(label, sizeof label, "filter, columns %s", name(level));
+            auto copy = column;
+            bench::report(label, bench::measure([&] {
+                han::columns::filter(copy, small, level);
+                bench::do_not_optimize(copy.bitmap());
+            }, size));
+        }
+    }
+}
+
+auto main() -> int {
+    run(0.5);
+    run(0.9);
+    run(1.0);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "bench.hh"
+#include <han/maybe.hh>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_set>
+
+namespace {
+    constexpr auto size = std::size_t{1} << 14;
+    constexpr auto lookups = std::size_t{1} << 18;
+
+    auto to_optional(const han::maybe<std::string>& m) -> std::optional<std::string> {
+        return m.then_do([](const std::string& s) { return std::optional<std::string>{s}; }).or_else(std::nullopt);
+    }
+}
+
+auto main() -> int {
+    auto random = std::mt19937{42};
+    auto names = std::vector<std::string>{};
+    for (auto i = std::size_t{0}; i < size; ++i) names.push_back("customer-name-" + std::to_string(random()));
+    auto probes = std::vector<std::string_view>{};
+    for (auto i = std::size_t{0}; i < lookups; ++i) probes.push_back(names[random() % size]);
+
+    auto keys = std::vector<han::maybe<std::string>>{};
+    for (const auto& name : names) keys.push_back(han::maybe{name});
+    keys.push_back(std::nullopt);
+
+    bench::report("hash, convert to std::optional", bench::measure([&] {
+        auto total = std::size_t{0};
+        for (const auto& key : keys)
+            total += std::hash<std::optional<std::string>>{}(to_optional(key));
+        bench::do_not_optimize(total);
+    }, keys.size()));
+    bench::report("hash, std::hash<maybe>", bench::measure([&] {
+        auto total = std::size_t{0};
+        for (const auto& key : keys) total += std::hash<han::maybe<std::string>>{}(key);
+        bench::do_not_optimize(total);
+    }, keys.size()));
+
+    auto index = std::map<han::maybe<std::string>, int, std::less<>>{};
+    for (const auto& key : keys) index.emplace(key, 1);
+    bench::report("map lookup, temporary maybe<string>", bench::measure([&] {
+        auto found = 0;
+        for (auto probe : probes) found += index.find(han::maybe{std::string{probe}})->second;
+        bench::do_not_optimize(found);
+    }, lookups));
+    bench::report("map lookup, string_view", bench::measure([&] {
+        auto found = 0;
+        for (auto probe : probes) found += index.find(probe)->second;
+        bench::do_not_optimize(found);
+    }, lookups));
+
+    auto set = std::unordered_set<han::maybe<std::string>>{keys.begin(), keys.end()};
+    bench::report("unordered_set lookup, maybe<string>", bench::measure([&] {
+        auto found = std::size_t{0};
+        for (const auto& key : keys) found += set.count(key);
+        bench::do_not_optimize(found);
+    }, keys.size()));
+    return 0;
+}
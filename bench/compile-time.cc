@@ -0,0 +1,35 @@
+#include <han/maybe.hh>
+#include <cstddef>
+#include <utility>
+
+#ifndef HAN_COMPILE_BENCH_CHAINS
+#define HAN_COMPILE_BENCH_CHAINS 10000
+#endif
+
+namespace {
+    template <std::size_t I>
+    auto chain(han::maybe<int> m) -> int {
+        auto seen = 0;
+        return std::move(m)
+            .then_do([](int x) { return x + static_cast<int>(I); })
+            .then_do([&](int x) { seen += x; })
+            .then_maybe([](int x) { return han::maybe{x * 2}; })
+            .or_else_do([&] { seen = -1; })
+            .or_else_do([] { return static_cast<int>(I); })
+            .or_maybe([] { return han::maybe{0}; })
+            .or_else(seen);
+    }
+
+    template <std::size_t... I>
+    auto run(int value, std::index_sequence<I...>) -> int {
+        using chain_type = int (*)(han::maybe<int>);
+        static constexpr chain_type chains[] = {&chain<I>...};
+        auto sum = 0;
+        for (auto f : chains) sum += f(han::maybe{value});
+        return sum;
+    }
+}
+
+auto main(int argc, char**) -> int {
+    return run(argc, std::make_index_sequence<HAN_COMPILE_BENCH_CHAINS>{}) == 0 ? 1 : 0;
+}
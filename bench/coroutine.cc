@@ -0,0 +1,117 @@
+#include "bench.hh"
+#include <han/coroutine.hh>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr auto nodes = std::size_t{1} << 16;
+    constexpr auto none = std::uint32_t{0xffff'ffff};
+
+    std::vector<std::uint32_t> next_of;
+
+    auto next(std::uint32_t node) noexcept -> han::maybe<std::uint32_t> {
+        if (auto n = next_of[node]; n != none) return han::maybe{n};
+        else return std::nullopt;
+    }
+
+    // Coroutine frames live and die inside the call that made them, so a
+    // stack of bytes that is popped in reverse order is enough to hold them.
+    class frame_stack {
+        alignas(std::max_align_t) std::byte bytes[4096];
+        std::size_t top = 0;
+
+    public:
+        auto push(std::size_t size) -> void* {
+            if (size > sizeof bytes - top) return ::operator new(size);
+            auto at = bytes + top;
+            top += size;
+            return at;
+        }
+
+        auto pop(void* p, std::size_t size) noexcept -> void {
+            if (std::less<>{}(p, bytes) || !std::less<>{}(p, bytes + sizeof bytes)) return ::operator delete(p, size);
+            top -= size;
+        }
+    };
+
+    template <typename T>
+    struct stack_allocator {
+        using value_type = T;
+
+        frame_stack* stack;
+
+        explicit stack_allocator(frame_stack& s) noexcept: stack(&s) {}
+
+        template <typename U>
+        stack_allocator(const stack_allocator<U>& other) noexcept: stack(other.stack) {}
+
+        auto allocate(std::size_t n) -> T* { return static_cast<T*>(stack->push(n * sizeof(T))); }
+        auto deallocate(T* p, std::size_t n) noexcept -> void { stack->pop(p, n * sizeof(T)); }
+
+        friend auto operator==(const stack_allocator& a, const stack_allocator& b) noexcept -> bool {
+            return a.stack == b.stack;
+        }
+    };
+
+    // Four dependent steps per start node, written four ways.
+    auto with_ifs(std::uint32_t start) noexcept -> han::maybe<std::uint32_t> {
+        auto a = next(start);
+        if (a == std::nullopt) return std::nullopt;
+        auto b = next(a.or_else(0));
+        if (b == std::nullopt) return std::nullopt;
+        auto c = next(b.or_else(0));
+        if (c == std::nullopt) return std::nullopt;
+        return next(c.or_else(0)).then_do([&](std::uint32_t d) { return a.or_else(0) ^ d; });
+    }
+
+    auto with_then_maybe(std::uint32_t start) noexcept -> han::maybe<std::uint32_t> {
+        return next(start).then_maybe([](std::uint32_t a) {
+            return next(a).then_maybe([a](std::uint32_t b) {
+                return next(b).then_maybe([a](std::uint32_t c) {
+                    return next(c).then_do([a](std::uint32_t d) { return a ^ d; });
+                });
+            });
+        });
+    }
+
+    auto with_coroutine(std::uint32_t start) -> han::maybe<std::uint32_t> {
+        auto a = co_await next(start);
+        auto b = co_await next(a);
+        auto c = co_await next(b);
+        co_return a ^ co_await next(c);
+    }
+
+    auto with_coroutine(std::allocator_arg_t, stack_allocator<std::byte>, std::uint32_t start) -> han::maybe<std::uint32_t> {
+        auto a = co_await next(start);
+        auto b = co_await next(a);
+        auto c = co_await next(b);
+        co_return a ^ co_await next(c);
+    }
+
+    template <typename F>
+    auto run(const char* name, F&& chain) -> void {
+        bench::report(name, bench::measure([&] {
+            auto total = std::uint64_t{0};
+            for (std::uint32_t i = 0; i < nodes; ++i) total += chain(i).or_else(0);
+            bench::do_not_optimize(total);
+        }, nodes));
+    }
+}
+
+auto main() -> int {
+    auto random = std::mt19937{42};
+    auto broken = std::bernoulli_distribution{0.05};
+    for (std::size_t i = 0; i < nodes; ++i)
+        next_of.push_back(broken(random) ? none : static_cast<std::uint32_t>(random() % nodes));
+
+    auto stack = frame_stack{};
+    run("hand-written ifs", with_ifs);
+    run("nested then_maybe", with_then_maybe);
+    run("coroutine, default frame allocation", [](std::uint32_t i) { return with_coroutine(i); });
+    run("coroutine, frame_stack allocator", [&](std::uint32_t i) {
+        return with_coroutine(std::allocator_arg, stack_allocator<std::byte>{stack}, i);
+    });
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "bench.hh"
+#include <han/first_present.hh>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace {
+    using namespace std::chrono_literals;
+
+    // Stand-ins for three sources of the same value. Each request sees the
+    // same hits, misses and delays whichever way the sources are combined.
+    auto mix(std::uint32_t key, std::uint32_t salt) noexcept -> std::uint32_t {
+        auto x = key * 0x9e37'79b9u ^ salt;
+        x ^= x >> 15;
+        x *= 0x2c1b'3c6du;
+        return x ^ x >> 12;
+    }
+
+    // With a token, the wait is cut short once the answer can't matter.
+    auto source(std::uint32_t key, std::uint32_t salt, unsigned hit_percent, std::chrono::microseconds usual,
+                std::chrono::microseconds slow, const han::cancel_token* token = nullptr) -> han::maybe<std::uint32_t> {
+        auto r = mix(key, salt);
+        auto until = std::chrono::steady_clock::now() + (r % 100 < 5 ? slow : usual);
+        while (std::chrono::steady_clock::now() < until) {
+            if (token != nullptr && token->cancelled()) return std::nullopt;
+            std::this_thread::sleep_for(token != nullptr ? 50us : until - std::chrono::steady_clock::now());
+        }
+        if (r / 100 % 100 < hit_percent) return han::maybe{key};
+        else return std::nullopt;
+    }
+
+    auto cache(std::uint32_t key, const han::cancel_token* token = nullptr) { return source(key, 1, 60, 50us, 400us, token); }
+    auto replica(std::uint32_t key, const han::cancel_token* token = nullptr) { return source(key, 2, 80, 400us, 3ms, token); }
+    auto origin(std::uint32_t key, const han::cancel_token* token = nullptr) { return source(key, 3, 100, 1500us, 8ms, token); }
+
+    template <typename F>
+    auto run(const char* name, F&& lookup) -> void {
+        constexpr auto requests = std::uint32_t{400};
+        auto latencies = std::vector<double>{};
+        for (std::uint32_t key = 0; key < requests; ++key) {
+            auto start = std::chrono::steady_clock::now();
+            bench::do_not_optimize(lookup(key));
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::printf("%-48s p50 %8.0f us   p90 %8.0f us   p99 %8.0f us\n", name, bench::percentile(latencies, 0.5),
+                    bench::percentile(latencies, 0.9), bench::percentile(latencies, 0.99));
+    }
+}
+
+auto main() -> int {
+    run("cache, or_maybe replica, or_maybe origin", [](std::uint32_t key) {
+        return cache(key).or_maybe([=] { return replica(key); }).or_maybe([=] { return origin(key); });
+    });
+
+    // Ignored alternatives keep their worker busy, and the next request
+    // queues behind them.
+    auto pool = han::thread_pool{3};
+    run("first_present, slower ones ignored", [&](std::uint32_t key) {
+        return han::first_present(pool, [=] { return cache(key); }, [=] { return replica(key); }, [=] { return origin(key); })
+            .get();
+    });
+    run("first_present, slower ones cancelled", [&](std::uint32_t key) {
+        return han::first_present(pool,
+                                  [=](const han::cancel_token& t) { return cache(key, &t); },
+                                  [=](const han::cancel_token& t) { return replica(key, &t); },
+                                  [=](const han::cancel_token& t) { return origin(key, &t); })
+            .get();
+    });
+    return 0;
+}
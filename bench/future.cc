@@ -0,0 +1,88 @@
+#include "bench.hh"
+#include <han/future.hh>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+    auto parse(int x) noexcept -> han::maybe<int> {
+        if (x % 16 != 0) return han::maybe{x};
+        else return std::nullopt;
+    }
+
+    // A lookup against a slow local store: mostly quick, sometimes not.
+    auto lookup(int key) -> han::maybe<int> {
+        auto spin_until = std::chrono::steady_clock::now() + std::chrono::microseconds(key % 64 == 0 ? 40 : 2);
+        while (std::chrono::steady_clock::now() < spin_until) {}
+        return parse(key);
+    }
+}
+
+auto main() -> int {
+    constexpr auto chains = std::size_t{1} << 16;
+
+    bench::report("maybe then_do/then_maybe/or_maybe", bench::measure([&] {
+        auto total = 0;
+        for (auto i = 0; i < static_cast<int>(chains); ++i)
+            total += parse(i).then_do([](int x) { return x + 1; }).then_maybe(parse).or_maybe([] { return han::maybe{0}; }).or_else(0);
+        bench::do_not_optimize(total);
+    }, chains));
+
+    bench::report("ready maybe_future, same chain", bench::measure([&] {
+        auto total = 0;
+        for (auto i = 0; i < static_cast<int>(chains); ++i)
+            total += han::maybe_future<int>{parse(i)}
+                         .then_do([](int x) { return x + 1; })
+                         .then_maybe(parse)
+                         .or_maybe([] { return han::maybe{0}; })
+                         .get()
+                         .or_else(0);
+        bench::do_not_optimize(total);
+    }, chains));
+
+    {
+        auto pool = han::thread_pool{1};
+        bench::report("pending maybe_future, same chain, 1 thread", bench::measure([&] {
+            auto total = 0;
+            for (auto i = 0; i < static_cast<int>(chains); ++i)
+                total += han::async(pool, [i] { return parse(i); })
+                             .then_do([](int x) { return x + 1; })
+                             .then_maybe(parse)
+                             .or_maybe([] { return han::maybe{0}; })
+                             .get()
+                             .or_else(0);
+            bench::do_not_optimize(total);
+        }, chains));
+    }
+
+    // Throughput and per-request latency with many lookups in flight.
+    // Latency is measured from submission to the continuation seeing the
+    // value, so it includes time spent queued.
+    constexpr auto requests = std::size_t{4096};
+    char label[96];
+    for (auto threads = std::size_t{1}; threads <= std::max<std::size_t>(han::thread_pool::default_size(), 4); threads *= 2) {
+        auto pool = han::thread_pool{threads};
+        auto latencies = std::vector<double>(requests);
+        auto futures = std::vector<han::maybe_future<int>>{};
+        futures.reserve(requests);
+        auto ns = bench::measure([&] {
+            futures.clear();
+            for (auto i = 0; i < static_cast<int>(requests); ++i) {
+                auto start = std::chrono::steady_clock::now();
+                futures.push_back(han::async(pool, [i] { return lookup(i); })
+                                      .or_maybe([] { return han::maybe{0}; })
+                                      .then_do([&latencies, start, i](int x) {
+                                          auto waited = std::chrono::steady_clock::now() - start;
+                                          latencies[static_cast<std::size_t>(i)] = std::chrono::duration<double, std::micro>(waited).count();
+                                          return x;
+                                      }));
+            }
+            for (auto& f : futures) f.wait();
+        }, requests, 5);
+        std::sort(latencies.begin(), latencies.end());
+        std::snprintf(label, sizeof label, "lookups, %zu threads (p50 %.0f us, p99 %.0f us)", threads,
+                      bench::percentile(latencies, 0.5), bench::percentile(latencies, 0.99));
+        bench::report(label, ns);
+    }
+    return 0;
+}
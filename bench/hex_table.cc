@@ -0,0 +1,72 @@
+#include "bench.hh"
+#include <han/zip.hh>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+    constexpr auto nibble(char c) noexcept -> han::maybe<std::uint8_t> {
+        if (c >= '0' && c <= '9') return han::maybe{static_cast<std::uint8_t>(c - '0')};
+        if (c >= 'a' && c <= 'f') return han::maybe{static_cast<std::uint8_t>(c - 'a' + 10)};
+        if (c >= 'A' && c <= 'F') return han::maybe{static_cast<std::uint8_t>(c - 'A' + 10)};
+        return std::nullopt;
+    }
+
+    constexpr auto hex_byte(char high, char low) noexcept -> han::maybe<std::uint8_t> {
+        return han::apply([](std::uint8_t h, std::uint8_t l) { return static_cast<std::uint8_t>(h << 4 | l); },
+                          nibble(high), nibble(low));
+    }
+
+    using table = std::array<han::maybe<std::uint8_t>, 65536>;
+
+    // Every pair of characters, indexed by (first << 8 | second), mapped
+    // through the same hex_byte() the runtime decoder calls.
+    constexpr auto make_table() noexcept -> table {
+        auto out = table{};
+        for (std::size_t i = 0; i < out.size(); ++i)
+            out[i] = hex_byte(static_cast<char>(i >> 8), static_cast<char>(i & 0xff));
+        return out;
+    }
+
+    constexpr auto pairs = make_table();
+
+    constexpr auto index(char high, char low) noexcept -> std::size_t {
+        return std::size_t{static_cast<unsigned char>(high)} << 8 | std::size_t{static_cast<unsigned char>(low)};
+    }
+
+    static_assert(pairs[index('f', 'f')] == 0xff);
+    static_assert(pairs[index('0', 'A')] == 0x0a);
+    static_assert(pairs[index('g', '0')] == std::nullopt);
+
+    template <typename Decode>
+    auto decode(const std::string& text, std::vector<std::uint8_t>& out, Decode byte) -> bool {
+        out.clear();
+        for (std::size_t i = 0; i + 1 < text.size(); i += 2) {
+            auto ok = byte(text[i], text[i + 1]).then_do([&](std::uint8_t b) { out.push_back(b); });
+            if (ok == std::nullopt) return false;
+        }
+        return true;
+    }
+}
+
+auto main() -> int {
+    constexpr auto size = std::size_t{1} << 20;
+    auto random = std::mt19937{42};
+    auto text = std::string{};
+    for (std::size_t i = 0; i < size * 2; ++i) text.push_back("0123456789abcdefABCDEF"[random() % 22]);
+    auto out = std::vector<std::uint8_t>{};
+    out.reserve(size);
+
+    bench::report("build the table at run time", bench::measure([] {
+        auto built = make_table();
+        bench::do_not_optimize(built);
+    }, 1, 5));
+    bench::report("decode, nibble() per character", bench::measure([&] {
+        bench::do_not_optimize(decode(text, out, hex_byte));
+    }, size));
+    bench::report("decode, compile-time table", bench::measure([&] {
+        bench::do_not_optimize(decode(text, out, [](char high, char low) { return pairs[index(high, low)]; }));
+    }, size));
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "bench.hh"
+#include <han/lazy.hh>
+#include <optional>
+#include <random>
+
+namespace {
+    constexpr auto f1 = [](int x) { return x * 3; };
+    constexpr auto f2 = [](int x) { return x + 7; };
+    constexpr auto f3 = [](int x) { return x ^ 0x55; };
+    constexpr auto f4 = [](int x) { return x >> 1; };
+    constexpr auto f5 = [](int x) { return x * 5; };
+    constexpr auto f6 = [](int x) { return x - 11; };
+
+    auto run(double ratio) -> void {
+        constexpr auto size = std::size_t{1} << 16;
+        auto random = std::mt19937{42};
+        auto coin = std::bernoulli_distribution{ratio};
+        auto maybes = std::vector<han::maybe<int>>{};
+        auto optionals = std::vector<std::optional<int>>{};
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            auto present = coin(random);
+            auto value = static_cast<int>(i);
+            maybes.push_back(present ? han::maybe{value} : han::maybe<int>{});
+            optionals.push_back(present ? std::optional{value} : std::nullopt);
+        }
+
+        bench::report("6 steps, hand-written if", bench::measure([&] {
+            auto sum = 0;
+            for (const auto& o : optionals) {
+                if (o) sum += f6(f5(f4(f3(f2(f1(*o))))));
+            }
+            bench::do_not_optimize(sum);
+        }, size));
+
+        bench::report("6 steps, eager maybe::then_do()", bench::measure([&] {
+            auto sum = 0;
+            for (const auto& m : maybes) {
+                sum += m.then_do(f1).then_do(f2).then_do(f3).then_do(f4).then_do(f5).then_do(f6).or_else(0);
+            }
+            bench::do_not_optimize(sum);
+        }, size));
+
+        bench::report("6 steps, lazy(maybe)::then_do()", bench::measure([&] {
+            auto sum = 0;
+            for (const auto& m : maybes) {
+                sum += han::lazy(m).then_do(f1).then_do(f2).then_do(f3).then_do(f4).then_do(f5).then_do(f6).or_else(0);
+            }
+            bench::do_not_optimize(sum);
+        }, size));
+    }
+}
+
+auto main() -> int {
+    std::printf("all present\n");
+    run(1.0);
+    std::printf("half present\n");
+    run(0.5);
+    return 0;
+}
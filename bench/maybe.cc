@@ -0,0 +1,287 @@
+#include "bench.hh"
+#include <han/lazy.hh>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <random>
+
+namespace {
+    template <std::size_t N>
+    struct payload {
+        unsigned char bytes[N];
+    };
+
+    auto first(int x) -> int { return x; }
+
+    template <std::size_t N>
+    auto first(const payload<N>& x) -> int { return x.bytes[0]; }
+
+    template <typename P>
+    auto make(int seed) -> P {
+        if constexpr (std::is_same_v<P, int>) {
+            return seed;
+        } else {
+            auto result = P{};
+            std::memset(result.bytes, seed & 0x7f, sizeof result.bytes);
+            return result;
+        }
+    }
+
+    struct options {
+        double ratio = 0.5;
+        int repetitions = 25;
+        int warmup = 2;
+    };
+
+    template <typename P>
+    struct data_set {
+        std::vector<han::maybe<P>> maybes;
+        std::vector<std::optional<P>> optionals;
+        std::vector<P> pool;
+        std::vector<const P*> pointers;
+        P fallback = make<P>(1);
+
+        data_set(std::size_t count, double ratio) {
+            auto random = std::mt19937{42};
+            auto coin = std::bernoulli_distribution{ratio};
+            pool.reserve(count);
+            for (auto i = std::size_t{0}; i < count; ++i) {
+                auto value = make<P>(static_cast<int>(i));
+                pool.push_back(value);
+                if (coin(random)) {
+                    maybes.emplace_back(value);
+                    optionals.emplace_back(value);
+                    pointers.push_back(&pool.back());
+                } else {
+                    maybes.emplace_back(std::nullopt);
+                    optionals.emplace_back(std::nullopt);
+                    pointers.push_back(nullptr);
+                }
+            }
+        }
+    };
+
+    class suite {
+        options opts;
+        bench::json_report json;
+
+    public:
+        explicit suite(options opts_): opts(opts_) {}
+
+        template <typename F>
+        auto run(const std::string& name, const char* variant, std::size_t payload_size, int depth,
+                 std::size_t ops, F&& body) -> void {
+            auto result = bench::measure_stats(std::forward<F>(body), ops, opts.repetitions, opts.warmup);
+            std::fprintf(stderr, "%-14s %-8s payload %5zu depth %2d  median %9.3f  p90 %9.3f  p99 %9.3f ns/op\n",
+                         name.c_str(), variant, payload_size, depth, result.median, result.p90, result.p99);
+            json.add(name, {{"variant", "\"" + std::string{variant} + "\""},
+                            {"payload", std::to_string(payload_size)},
+                            {"depth", std::to_string(depth)},
+                            {"ratio", std::to_string(opts.ratio)}}, result);
+        }
+
+        auto ratio() const -> double { return opts.ratio; }
+        auto write() const -> void { json.write(stdout); }
+    };
+
+    template <typename P>
+    auto combinators(suite& s) -> void {
+        auto count = std::clamp<std::size_t>((std::size_t{1} << 23) / sizeof(P), 1024, 65536);
+        auto data = data_set<P>{count, s.ratio()};
+        auto size = sizeof(P);
+        auto step = [](const P& x) { return first(x) + 1; };
+        auto lookup = [](const P& x) { return first(x) % 2 == 0 ? han::maybe{first(x)} : han::maybe<int>{}; };
+        auto lookup_optional = [](const P& x) { return first(x) % 2 == 0 ? std::optional{first(x)} : std::nullopt; };
+
+        s.run("or_else", "maybe", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& m : data.maybes) acc += first(m.or_else(data.fallback));
+            bench::do_not_optimize(acc);
+        });
+        s.run("or_else", "optional", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& o : data.optionals) acc += first(o.value_or(data.fallback));
+            bench::do_not_optimize(acc);
+        });
+        s.run("or_else", "pointer", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto* p : data.pointers) acc += first(p ? *p : data.fallback);
+            bench::do_not_optimize(acc);
+        });
+
+        s.run("then_do", "maybe", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& m : data.maybes) acc += m.then_do(step).or_else(0);
+            bench::do_not_optimize(acc);
+        });
+        s.run("then_do", "optional", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& o : data.optionals) acc += o ? step(*o) : 0;
+            bench::do_not_optimize(acc);
+        });
+        s.run("then_do", "pointer", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto* p : data.pointers) acc += p ? step(*p) : 0;
+            bench::do_not_optimize(acc);
+        });
+
+        s.run("then_do_void", "maybe", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& m : data.maybes) m.then_do([&](const P& x) { acc += first(x); });
+            bench::do_not_optimize(acc);
+        });
+        s.run("then_do_void", "optional", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& o : data.optionals) if (o) acc += first(*o);
+            bench::do_not_optimize(acc);
+        });
+        s.run("then_do_void", "pointer", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto* p : data.pointers) if (p) acc += first(*p);
+            bench::do_not_optimize(acc);
+        });
+
+        s.run("or_else_do", "maybe", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& m : data.maybes)
+                acc += m.or_else_do([&] { return data.fallback; }).then_do(step).or_else(0);
+            bench::do_not_optimize(acc);
+        });
+        s.run("or_else_do", "optional", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& o : data.optionals) acc += o ? step(*o) : step(data.fallback);
+            bench::do_not_optimize(acc);
+        });
+        s.run("or_else_do", "pointer", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto* p : data.pointers) acc += step(p ? *p : data.fallback);
+            bench::do_not_optimize(acc);
+        });
+
+        s.run("or_else_do_void", "maybe", size, 0, count, [&] {
+            auto misses = 0;
+            for (const auto& m : data.maybes) m.or_else_do([&] { ++misses; });
+            bench::do_not_optimize(misses);
+        });
+        s.run("or_else_do_void", "optional", size, 0, count, [&] {
+            auto misses = 0;
+            for (const auto& o : data.optionals) if (!o) ++misses;
+            bench::do_not_optimize(misses);
+        });
+        s.run("or_else_do_void", "pointer", size, 0, count, [&] {
+            auto misses = 0;
+            for (const auto* p : data.pointers) if (!p) ++misses;
+            bench::do_not_optimize(misses);
+        });
+
+        s.run("then_maybe", "maybe", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& m : data.maybes) acc += m.then_maybe(lookup).or_else(0);
+            bench::do_not_optimize(acc);
+        });
+        s.run("then_maybe", "optional", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& o : data.optionals) acc += o ? lookup_optional(*o).value_or(0) : 0;
+            bench::do_not_optimize(acc);
+        });
+        s.run("then_maybe", "pointer", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto* p : data.pointers) acc += p && first(*p) % 2 == 0 ? first(*p) : 0;
+            bench::do_not_optimize(acc);
+        });
+
+        s.run("or_maybe", "maybe", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& m : data.maybes)
+                acc += m.or_maybe([&] { return han::maybe{data.fallback}; }).then_do(step).or_else(0);
+            bench::do_not_optimize(acc);
+        });
+        s.run("or_maybe", "optional", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto& o : data.optionals) {
+                auto alt = o ? o : std::optional{data.fallback};
+                acc += alt ? step(*alt) : 0;
+            }
+            bench::do_not_optimize(acc);
+        });
+        s.run("or_maybe", "pointer", size, 0, count, [&] {
+            auto acc = 0;
+            for (const auto* p : data.pointers) {
+                const auto* alt = p ? p : &data.fallback;
+                acc += alt ? step(*alt) : 0;
+            }
+            bench::do_not_optimize(acc);
+        });
+    }
+
+    constexpr auto step = [](int x) { return x * 3 + 1; };
+
+    template <int Depth>
+    auto eager_chain(const han::maybe<int>& m) -> han::maybe<int> {
+        if constexpr (Depth == 1) return m.then_do(step);
+        else return eager_chain<Depth - 1>(m).then_do(step);
+    }
+
+    template <int Depth, typename L>
+    auto lazy_chain(L&& chain) {
+        if constexpr (Depth == 0) return std::forward<L>(chain);
+        else return lazy_chain<Depth - 1>(std::forward<L>(chain).then_do(step));
+    }
+
+    template <int Depth>
+    auto chain(suite& s) -> void {
+        auto count = std::size_t{65536};
+        auto data = data_set<int>{count, s.ratio()};
+
+        s.run("chain", "maybe", sizeof(int), Depth, count, [&] {
+            auto acc = 0;
+            for (const auto& m : data.maybes) acc += eager_chain<Depth>(m).or_else(0);
+            bench::do_not_optimize(acc);
+        });
+        s.run("chain", "lazy", sizeof(int), Depth, count, [&] {
+            auto acc = 0;
+            for (const auto& m : data.maybes) acc += lazy_chain<Depth>(han::lazy(m)).or_else(0);
+            bench::do_not_optimize(acc);
+        });
+        s.run("chain", "optional", sizeof(int), Depth, count, [&] {
+            auto acc = 0;
+            for (const auto& o : data.optionals) {
+                if (o) {
+                    auto x = *o;
+                    for (auto i = 0; i < Depth; ++i) x = step(x);
+                    acc += x;
+                }
+            }
+            bench::do_not_optimize(acc);
+        });
+    }
+
+    auto parse(int argc, char** argv) -> options {
+        auto result = options{};
+        for (auto i = 1; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--ratio") == 0) result.ratio = std::atof(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--repetitions") == 0) result.repetitions = std::atoi(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--warmup") == 0) result.warmup = std::atoi(argv[i + 1]);
+        }
+        return result;
+    }
+}
+
+auto main(int argc, char** argv) -> int {
+    auto s = suite{parse(argc, argv)};
+
+    combinators<int>(s);
+    combinators<payload<64>>(s);
+    combinators<payload<512>>(s);
+    combinators<payload<4096>>(s);
+
+    chain<1>(s);
+    chain<2>(s);
+    chain<4>(s);
+    chain<8>(s);
+    chain<16>(s);
+    chain<32>(s);
+
+    s.write();
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "bench.hh"
+#include <han/parallel.hh>
+#include <random>
+#include <unordered_map>
+
+auto main() -> int {
+    constexpr auto size = std::size_t{1'000'000};
+    auto random = std::mt19937{42};
+    auto keys = std::vector<han::maybe<int>>{};
+    auto table = std::unordered_map<int, int>{};
+    for (auto i = 0; i < 1 << 18; ++i) table.emplace(i * 7, i);
+    for (auto i = std::size_t{0}; i < size; ++i) {
+        if (random() % 10 != 0) keys.emplace_back(static_cast<int>(random() % (7u << 18)));
+        else keys.emplace_back(std::nullopt);
+    }
+    auto lookup = [&](int key) {
+        if (auto it = table.find(key); it != table.end()) return han::maybe{it->second};
+        else return han::maybe<int>{};
+    };
+    auto out = std::vector<han::maybe<int>>(size);
+
+    auto serial = bench::measure([&] {
+        for (auto i = std::size_t{0}; i < size; ++i) out[i] = keys[i].then_maybe(lookup);
+        bench::do_not_optimize(out.data());
+    }, size, 5);
+    bench::report("then_maybe() loop", serial);
+
+    char label[64];
+    for (auto threads = std::size_t{1}; threads <= han::thread_pool::default_size(); threads *= 2) {
+        auto pool = han::thread_pool{threads};
+        auto ns = bench::measure([&] {
+            han::then_maybe_each(pool, keys.begin(), keys.end(), out.begin(), lookup);
+            bench::do_not_optimize(out.data());
+        }, size, 5);
+        std::snprintf(label, sizeof label, "then_maybe_each(), %zu threads (x%.2f)", threads, serial / ns);
+        bench::report(label, ns);
+    }
+
+#if defined(__cpp_lib_execution) && defined(HAN_HAVE_TBB)
+    auto par = bench::measure([&] {
+        han::then_maybe_each(std::execution::par, keys.begin(), keys.end(), out.begin(), lookup);
+        bench::do_not_optimize(out.data());
+    }, size, 5);
+    std::snprintf(label, sizeof label, "then_maybe_each(), std::execution::par (x%.2f)", serial / par);
+    bench::report(label, par);
+#endif
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "bench.hh"
+#include <han/relocate.hh>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace {
+    constexpr auto size = std::size_t{1} << 18;
+
+    class heap_string {
+        std::unique_ptr<char[]> chars;
+        std::size_t length = 0;
+
+    public:
+        heap_string(std::size_t n, char c): chars(std::make_unique<char[]>(n)), length(n) {
+            std::memset(chars.get(), c, n);
+        }
+
+        auto size() const noexcept -> std::size_t { return length; }
+    };
+}
+
+template <>
+struct han::is_trivially_relocatable<heap_string> : std::true_type {};
+
+namespace {
+    template <typename T, bool Relocate>
+    class growing {
+        std::allocator<T> allocator;
+        T* items = nullptr;
+        std::size_t count = 0;
+        std::size_t capacity = 0;
+
+    public:
+        growing() = default;
+        growing(const growing&) = delete;
+        auto operator=(const growing&) -> growing& = delete;
+
+        ~growing() {
+            std::destroy(items, items + count);
+            if (items) allocator.deallocate(items, capacity);
+        }
+
+        template <typename... Args>
+        auto emplace_back(Args&&... args) -> void {
+            if (count == capacity) grow();
+            new (items + count) T(std::forward<Args>(args)...);
+            ++count;
+        }
+
+        auto data() const noexcept -> const T* { return items; }
+
+    private:
+        auto grow() -> void {
+            auto next = capacity ? capacity * 2 : 16;
+            auto* fresh = allocator.allocate(next);
+            if constexpr (Relocate) {
+                han::relocate(items, items + count, fresh);
+            } else {
+                std::uninitialized_move(items, items + count, fresh);
+                std::destroy(items, items + count);
+            }
+            if (items) allocator.deallocate(items, capacity);
+            items = fresh;
+            capacity = next;
+        }
+    };
+
+    template <typename Container>
+    auto fill() -> void {
+        auto items = Container{};
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            if (i % 4 == 0) items.emplace_back();
+            else items.emplace_back(std::in_place, 24, 'x');
+        }
+        bench::do_not_optimize(items.data());
+    }
+
+    template <typename T, bool Relocate>
+    auto move_all(T* from, T* to) -> void {
+        if constexpr (Relocate) {
+            han::relocate(from, from + size, to);
+        } else {
+            std::uninitialized_move(from, from + size, to);
+            std::destroy(from, from + size);
+        }
+    }
+
+    template <typename T, bool Relocate>
+    auto grow_only() -> double {
+        auto allocator = std::allocator<T>{};
+        auto* a = allocator.allocate(size);
+        auto* b = allocator.allocate(size);
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            if (i % 4 == 0) new (a + i) T{};
+            else new (a + i) T{std::in_place, 24, 'x'};
+        }
+        auto result = bench::measure([&] {
+            move_all<T, Relocate>(a, b);
+            bench::clobber();
+            move_all<T, Relocate>(b, a);
+            bench::do_not_optimize(a);
+        }, 2 * size);
+        std::destroy(a, a + size);
+        allocator.deallocate(a, size);
+        allocator.deallocate(b, size);
+        return result;
+    }
+}
+
+auto main() -> int {
+    using string_like = han::maybe<heap_string>;
+    static_assert(han::is_trivially_relocatable_v<string_like>);
+
+    std::printf("push_back with growth, per element\n");
+    bench::report("vector<maybe<std::string>>", bench::measure([] {
+        fill<std::vector<han::maybe<std::string>>>();
+    }, size));
+    bench::report("vector<maybe<heap_string>>", bench::measure([] {
+        fill<std::vector<string_like>>();
+    }, size));
+    bench::report("growing<maybe<heap_string>>, move + destroy", bench::measure([] {
+        fill<growing<string_like, false>>();
+    }, size));
+    bench::report("growing<maybe<heap_string>>, han::relocate", bench::measure([] {
+        fill<growing<string_like, true>>();
+    }, size));
+
+    std::printf("one reallocation, per element\n");
+    bench::report("maybe<std::string>, move + destroy", grow_only<han::maybe<std::string>, false>());
+    bench::report("maybe<heap_string>, move + destroy", grow_only<string_like, false>());
+    bench::report("maybe<heap_string>, han::relocate", grow_only<string_like, true>());
+    return 0;
+}
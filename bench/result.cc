@@ -0,0 +1,145 @@
+#include "bench.hh"
+#include <han/result.hh>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    constexpr auto tokens = std::size_t{1} << 16;
+    constexpr auto limit = 500'000;
+
+    enum class error_code : std::uint8_t { empty, not_a_digit, too_large };
+
+    struct tally {
+        long sum = 0;
+        std::array<std::size_t, 3> errors = {};
+
+        auto fail(error_code e) noexcept -> void { ++errors[static_cast<std::size_t>(e)]; }
+    };
+
+    // Two fallible steps per token, written three ways.
+    auto parse_result(std::string_view text) noexcept -> han::result<int, error_code> {
+        if (text.empty()) return han::fail(error_code::empty);
+        auto value = 0;
+        for (auto c : text) {
+            if (c < '0' || c > '9') return han::fail(error_code::not_a_digit);
+            value = value * 10 + (c - '0');
+        }
+        return han::result<int, error_code>{value};
+    }
+
+    auto check_result(int value) noexcept -> han::result<int, error_code> {
+        if (value > limit) return han::fail(error_code::too_large);
+        else return han::result<int, error_code>{value};
+    }
+
+    auto parse_out(std::string_view text, error_code& error) noexcept -> han::maybe<int> {
+        if (text.empty()) {
+            error = error_code::empty;
+            return std::nullopt;
+        }
+        auto value = 0;
+        for (auto c : text) {
+            if (c < '0' || c > '9') {
+                error = error_code::not_a_digit;
+                return std::nullopt;
+            }
+            value = value * 10 + (c - '0');
+        }
+        return han::maybe{value};
+    }
+
+    auto check_out(int value, error_code& error) noexcept -> han::maybe<int> {
+        if (value > limit) {
+            error = error_code::too_large;
+            return std::nullopt;
+        }
+        return han::maybe{value};
+    }
+
+#if defined(__cpp_exceptions)
+    struct parse_error {
+        error_code code;
+    };
+
+    auto parse_throw(std::string_view text) -> int {
+        if (text.empty()) throw parse_error{error_code::empty};
+        auto value = 0;
+        for (auto c : text) {
+            if (c < '0' || c > '9') throw parse_error{error_code::not_a_digit};
+            value = value * 10 + (c - '0');
+        }
+        return value;
+    }
+
+    auto check_throw(int value) -> int {
+        if (value > limit) throw parse_error{error_code::too_large};
+        return value;
+    }
+#endif
+
+    auto make_tokens(double errors) -> std::vector<std::string> {
+        auto random = std::mt19937{42};
+        auto coin = std::bernoulli_distribution{errors};
+        auto out = std::vector<std::string>{};
+        for (std::size_t i = 0; i < tokens; ++i) {
+            auto text = std::to_string(random() % limit);
+            if (coin(random)) {
+                switch (random() % 3) {
+                    case 0: text.clear(); break;
+                    case 1: text[text.size() / 2] = 'x'; break;
+                    default: text = std::to_string(limit + 1 + random() % limit); break;
+                }
+            }
+            out.push_back(std::move(text));
+        }
+        return out;
+    }
+}
+
+auto main() -> int {
+    for (auto errors : {0.0, 0.01, 0.1, 0.5}) {
+        auto input = make_tokens(errors);
+        auto label = [&](const char* how) {
+            return std::string{how} + ", " + std::to_string(static_cast<int>(errors * 100)) + "% errors";
+        };
+
+        bench::report(label("result<int, error_code>").c_str(), bench::measure([&] {
+            auto t = tally{};
+            for (const auto& text : input)
+                parse_result(text)
+                    .then_maybe(check_result)
+                    .then_do([&](int x) { t.sum += x; })
+                    .or_else_do([&](error_code e) { t.fail(e); });
+            bench::do_not_optimize(t);
+        }, tokens));
+        bench::report(label("maybe<int> + error out-parameter").c_str(), bench::measure([&] {
+            auto t = tally{};
+            for (const auto& text : input) {
+                auto error = error_code::empty;
+                parse_out(text, error)
+                    .then_maybe([&](int x) { return check_out(x, error); })
+                    .then_do([&](int x) { t.sum += x; })
+                    .or_else_do([&] { t.fail(error); });
+            }
+            bench::do_not_optimize(t);
+        }, tokens));
+#if defined(__cpp_exceptions)
+        bench::report(label("exceptions").c_str(), bench::measure([&] {
+            auto t = tally{};
+            for (const auto& text : input) {
+                try {
+                    t.sum += check_throw(parse_throw(text));
+                } catch (const parse_error& e) {
+                    t.fail(e.code);
+                }
+            }
+            bench::do_not_optimize(t);
+        }, tokens));
+#endif
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "bench.hh"
+#include <han/serialize.hh>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace {
+    constexpr auto records = std::size_t{1} << 14;
+
+    struct record {
+        han::maybe<std::int32_t> i0, i1, i2, i3, i4, i5, i6, i7;
+        han::maybe<double> d0, d1, d2, d3, d4, d5, d6, d7;
+        han::maybe<std::string> s0, s1, s2, s3, s4, s5, s6, s7;
+    };
+}
+
+template <>
+struct han::serial_traits<record> {
+    template <typename R>
+    constexpr static auto tie(R& r) noexcept {
+        return std::tie(r.i0, r.i1, r.i2, r.i3, r.i4, r.i5, r.i6, r.i7, r.d0, r.d1, r.d2, r.d3, r.d4, r.d5, r.d6, r.d7,
+                        r.s0, r.s1, r.s2, r.s3, r.s4, r.s5, r.s6, r.s7);
+    }
+};
+
+namespace {
+    // One presence byte per field, followed by the payload when present:
+    // fixed-width payloads as raw bytes, strings as a 32-bit length and bytes.
+    struct naive {
+        template <typename T>
+        static auto write(std::vector<std::byte>& out, const han::maybe<T>& field) -> void {
+            out.push_back(field.then_do([](const T&) { return std::byte{1}; }).or_else(std::byte{0}));
+            field.then_do([&](const T& value) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    auto size = static_cast<std::uint32_t>(value.size());
+                    append(out, &size, sizeof size);
+                    append(out, value.data(), value.size());
+                } else {
+                    append(out, &value, sizeof value);
+                }
+            });
+        }
+
+        template <typename T>
+        static auto read(const std::byte*& in, han::maybe<T>& field) -> void {
+            if (*in++ == std::byte{0}) {
+                field.reset();
+                return;
+            }
+            if constexpr (std::is_same_v<T, std::string>) {
+                auto size = std::uint32_t{};
+                std::memcpy(&size, in, sizeof size);
+                in += sizeof size;
+                field.emplace(reinterpret_cast<const char*>(in), size);
+                in += size;
+            } else {
+                auto value = T{};
+                std::memcpy(&value, in, sizeof value);
+                in += sizeof value;
+                field.emplace(value);
+            }
+        }
+
+        static auto append(std::vector<std::byte>& out, const void* data, std::size_t size) -> void {
+            auto at = out.size();
+            out.resize(at + size);
+            std::memcpy(out.data() + at, data, size);
+        }
+    };
+
+    auto make_records(double ratio) -> std::vector<record> {
+        auto random = std::mt19937{42};
+        auto coin = std::bernoulli_distribution{ratio};
+        auto out = std::vector<record>(records);
+        for (auto& r : out) {
+            std::apply([&](auto&... fields) {
+                auto fill = [&](auto& field) {
+                    using T = han::detail::payload_t<decltype(field)>;
+                    if (!coin(random)) return;
+                    if constexpr (std::is_same_v<T, std::string>) field.emplace(8 + random() % 16, 'x');
+                    else field.emplace(static_cast<T>(random() % 1000));
+                };
+                (fill(fields), ...);
+            }, han::serial_traits<record>::tie(r));
+        }
+        return out;
+    }
+
+    auto run(double ratio) -> void {
+        auto input = make_records(ratio);
+        auto wire = std::vector<std::byte>{};
+        auto output = std::vector<record>(records);
+
+        auto encode_naive = [&] {
+            wire.clear();
+            for (const auto& r : input)
+                std::apply([&](const auto&... fields) { (naive::write(wire, fields), ...); }, han::serial_traits<record>::tie(r));
+        };
+        encode_naive();
+        std::printf("naive: %.1f bytes/record\n", static_cast<double>(wire.size()) / records);
+        bench::report("naive encode", bench::measure([&] { encode_naive(); bench::do_not_optimize(wire.data()); }, records));
+        bench::report("naive decode", bench::measure([&] {
+            auto in = static_cast<const std::byte*>(wire.data());
+            for (auto& r : output)
+                std::apply([&](auto&... fields) { (naive::read(in, fields), ...); }, han::serial_traits<record>::tie(r));
+            bench::do_not_optimize(output.data());
+        }, records));
+
+        auto encode_packed = [&] {
+            wire.clear();
+            for (const auto& r : input) han::serialize(r, wire);
+        };
+        encode_packed();
+        std::printf("packed: %.1f bytes/record\n", static_cast<double>(wire.size()) / records);
+        bench::report("han::serialize", bench::measure([&] { encode_packed(); bench::do_not_optimize(wire.data()); }, records));
+        bench::report("han::deserialize", bench::measure([&] {
+            auto at = std::size_t{0};
+            for (auto& r : output) at += han::deserialize(wire.data() + at, wire.size() - at, r).or_else(0);
+            bench::do_not_optimize(at);
+        }, records));
+    }
+}
+
+auto main() -> int {
+    std::printf("30%% of fields present\n");
+    run(0.3);
+    std::printf("90%% of fields present\n");
+    run(0.9);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "bench.hh"
+#include <han/views.hh>
+#include <random>
+#include <string>
+
+namespace {
+    constexpr auto size = std::size_t{1} << 20;
+
+    template <typename T, typename Make>
+    auto input(double ratio, Make make) -> std::vector<han::maybe<T>> {
+        auto random = std::mt19937{42};
+        auto coin = std::bernoulli_distribution{ratio};
+        auto out = std::vector<han::maybe<T>>{};
+        out.reserve(size);
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            if (coin(random)) out.push_back(han::maybe<T>{make(i)});
+            else out.push_back(std::nullopt);
+        }
+        return out;
+    }
+
+    auto run(double ratio) -> void {
+        auto ints = input<int>(ratio, [](std::size_t i) { return static_cast<int>(i % 1000); });
+        auto strings = input<std::string>(ratio, [](std::size_t i) { return std::string(24 + i % 8, 'x'); });
+        auto twice = [](int x) { return x * 2; };
+
+        bench::report("int, copy present then loop", bench::measure([&] {
+            auto present = std::vector<int>{};
+            for (const auto& m : ints) m.then_do([&](int x) { present.push_back(x); });
+            auto sum = 0;
+            for (auto x : present) sum += x;
+            bench::do_not_optimize(sum);
+        }, size));
+        bench::report("int, views::present", bench::measure([&] {
+            auto sum = 0;
+            for (auto x : ints | han::views::present) sum += x;
+            bench::do_not_optimize(sum);
+        }, size));
+        bench::report("int, views::flatten", bench::measure([&] {
+            auto sum = 0;
+            for (auto x : ints | han::views::flatten) sum += x;
+            bench::do_not_optimize(sum);
+        }, size));
+
+        bench::report("int, transform into vector then copy present", bench::measure([&] {
+            auto mapped = std::vector<han::maybe<int>>{};
+            mapped.reserve(ints.size());
+            for (const auto& m : ints) mapped.push_back(m.then_do(twice));
+            auto present = std::vector<int>{};
+            for (const auto& m : mapped) m.then_do([&](int x) { present.push_back(x); });
+            auto sum = 0;
+            for (auto x : present) sum += x;
+            bench::do_not_optimize(sum);
+        }, size));
+        bench::report("int, views::transform_maybe | present", bench::measure([&] {
+            auto sum = 0;
+            for (auto x : ints | han::views::transform_maybe(twice) | han::views::present) sum += x;
+            bench::do_not_optimize(sum);
+        }, size));
+
+        bench::report("string, copy present then loop", bench::measure([&] {
+            auto present = std::vector<std::string>{};
+            for (const auto& m : strings) m.then_do([&](const std::string& x) { present.push_back(x); });
+            auto total = std::size_t{0};
+            for (const auto& x : present) total += x.size();
+            bench::do_not_optimize(total);
+        }, size));
+        bench::report("string, views::present", bench::measure([&] {
+            auto total = std::size_t{0};
+            for (const auto& x : strings | han::views::present) total += x.size();
+            bench::do_not_optimize(total);
+        }, size));
+    }
+}
+
+auto main() -> int {
+    std::printf("all present\n");
+    run(1.0);
+    std::printf("half present\n");
+    run(0.5);
+    return 0;
+}
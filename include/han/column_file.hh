@@ -0,0 +1,316 @@
+#ifndef HAN_COLUMN_FILE_HH
+#define HAN_COLUMN_FILE_HH
+#include <han/maybe_vector.hh>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "han/column_file.hh maps values in native byte order");
+
+namespace han {
+    // On disk a column is this header followed by the validity bitmap (64-bit
+    // words, bit i of word i / 64 set when row i is present), the values (one
+    // slot per row, zero when absent) and, for strings, rows + 1 offsets into
+    // the characters. Every region starts on a 64-byte boundary.
+    struct column_header {
+        char magic[8];
+        std::uint32_t kind;
+        std::uint32_t value_size;
+        std::uint64_t rows;
+        std::uint64_t validity;
+        std::uint64_t values;
+        std::uint64_t offsets;
+        std::uint64_t bytes;
+    };
+
+    namespace detail {
+        constexpr char column_magic[8] = {'h', 'a', 'n', 'c', 'o', 'l', '1', '\0'};
+        constexpr std::uint64_t column_alignment = 64;
+
+        enum class column_kind : std::uint32_t { fixed = 0, text = 1 };
+
+        template <typename T>
+        constexpr bool is_text_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+        template <typename T>
+        constexpr auto column_kind_of() noexcept -> column_kind {
+            return is_text_v<T> ? column_kind::text : column_kind::fixed;
+        }
+
+        constexpr auto align_column(std::uint64_t offset) noexcept -> std::uint64_t {
+            return (offset + column_alignment - 1) / column_alignment * column_alignment;
+        }
+
+        constexpr auto column_words(std::size_t rows) noexcept -> std::size_t {
+            return (rows + 63) / 64;
+        }
+
+        template <typename R>
+        using column_element_t = std::remove_cv_t<std::remove_reference_t<payload_t<decltype(*std::begin(std::declval<const R&>()))>>>;
+
+        class column_writer {
+            std::FILE* file;
+            std::uint64_t written = 0;
+            bool failed = false;
+
+        public:
+            explicit column_writer(const char* path) noexcept: file(std::fopen(path, "wb")), failed(file == nullptr) {}
+            column_writer(const column_writer&) = delete;
+            auto operator=(const column_writer&) -> column_writer& = delete;
+            ~column_writer() { if (file != nullptr) std::fclose(file); }
+
+            auto write(const void* data, std::size_t size) noexcept -> void {
+                if (failed || size == 0) return;
+                failed = std::fwrite(data, 1, size, file) != size;
+                written += size;
+            }
+
+            auto pad_to(std::uint64_t offset) noexcept -> void {
+                constexpr char zeros[column_alignment] = {};
+                while (!failed && written < offset)
+                    write(zeros, std::min<std::size_t>(offset - written, column_alignment));
+            }
+
+            auto close() noexcept -> bool {
+                if (file == nullptr) return false;
+                failed = std::fclose(file) != 0 || failed;
+                file = nullptr;
+                return !failed;
+            }
+        };
+    }
+
+    template <typename R>
+    auto write_column(const char* path, const R& column) -> bool {
+        using T = detail::column_element_t<R>;
+        static_assert(detail::is_text_v<T> || std::is_trivially_copyable_v<T>,
+                      "write_column() needs a column of trivially copyable values or strings");
+        static_assert(alignof(T) <= detail::column_alignment, "column values must fit the 64-byte region alignment");
+
+        auto validity = std::vector<std::uint64_t>{};
+        auto rows = std::size_t{0};
+        auto characters = std::size_t{0};
+        for (auto&& m : column) {
+            if (rows % 64 == 0) validity.push_back(0);
+            if (detail::access::has_value(m)) {
+                validity.back() |= std::uint64_t{1} << (rows % 64);
+                if constexpr (detail::is_text_v<T>) characters += detail::access::value(m).size();
+            }
+            ++rows;
+        }
+
+        auto header = column_header{};
+        std::memcpy(header.magic, detail::column_magic, sizeof header.magic);
+        header.kind = static_cast<std::uint32_t>(detail::column_kind_of<T>());
+        header.value_size = detail::is_text_v<T> ? 1 : static_cast<std::uint32_t>(sizeof(T));
+        header.rows = rows;
+        header.validity = detail::align_column(sizeof header);
+        header.values = detail::align_column(header.validity + validity.size() * sizeof(std::uint64_t));
+        if constexpr (detail::is_text_v<T>) {
+            header.offsets = header.values;
+            header.values = detail::align_column(header.offsets + (rows + 1) * sizeof(std::uint64_t));
+            header.bytes = header.values + characters;
+        } else {
+            header.bytes = header.values + rows * sizeof(T);
+        }
+
+        auto out = detail::column_writer{path};
+        out.write(&header, sizeof header);
+        out.pad_to(header.validity);
+        out.write(validity.data(), validity.size() * sizeof(std::uint64_t));
+        if constexpr (detail::is_text_v<T>) {
+            out.pad_to(header.offsets);
+            auto offset = std::uint64_t{0};
+            out.write(&offset, sizeof offset);
+            for (auto&& m : column) {
+                if (detail::access::has_value(m)) offset += detail::access::value(m).size();
+                out.write(&offset, sizeof offset);
+            }
+            out.pad_to(header.values);
+            for (auto&& m : column)
+                if (detail::access::has_value(m)) {
+                    const auto& text = detail::access::value(m);
+                    out.write(text.data(), text.size());
+                }
+        } else if constexpr (std::is_same_v<R, maybe_vector<T>>) {
+            // Absent slots may still hold what filter() or reset() left, so a
+            // word with any of them goes through a copy they are cleared in.
+            out.pad_to(header.values);
+            auto block = std::vector<std::byte>(64 * sizeof(T));
+            for (std::size_t first = 0; first < rows; first += 64) {
+                auto count = std::min<std::size_t>(64, rows - first);
+                auto word = validity[first / 64];
+                if (word == ~std::uint64_t{0}) {
+                    out.write(column.data() + first, count * sizeof(T));
+                    continue;
+                }
+                std::memcpy(block.data(), column.data() + first, count * sizeof(T));
+                for (std::size_t i = 0; i < count; ++i)
+                    if ((word >> i & 1) == 0) std::memset(block.data() + i * sizeof(T), 0, sizeof(T));
+                out.write(block.data(), count * sizeof(T));
+            }
+        } else {
+            out.pad_to(header.values);
+            const auto zero = T{};
+            for (auto&& m : column)
+                out.write(detail::access::has_value(m) ? std::addressof(detail::access::value(m)) : &zero, sizeof(T));
+        }
+        return out.close();
+    }
+
+    template <typename T>
+    class mapped_column {
+        static_assert(std::is_same_v<T, std::string_view> || (std::is_trivially_copyable_v<T> && !detail::is_text_v<T>),
+                      "mapped_column<T> needs a trivially copyable T, or std::string_view for string columns");
+
+        constexpr static bool text = std::is_same_v<T, std::string_view>;
+
+        const std::byte* base = nullptr;
+        std::size_t length = 0;
+        std::size_t rows = 0;
+        const std::uint64_t* validity = nullptr;
+        const std::byte* values = nullptr;
+        const std::uint64_t* offsets = nullptr;
+        std::size_t characters = 0;
+
+    public:
+        using value_type = std::conditional_t<text, maybe<std::string_view>, maybe<const T&>>;
+        using size_type = std::size_t;
+
+        class iterator {
+            const mapped_column* owner = nullptr;
+            size_type index = 0;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = typename mapped_column::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type;
+            using pointer = void;
+
+            constexpr iterator() noexcept = default;
+            constexpr iterator(const mapped_column* owner_, size_type index_) noexcept: owner(owner_), index(index_) {}
+
+            auto operator*() const noexcept -> reference { return (*owner)[index]; }
+            auto operator++() noexcept -> iterator& { ++index; return *this; }
+            auto operator++(int) noexcept -> iterator { auto copy = *this; ++index; return copy; }
+
+            auto operator==(const iterator& other) const noexcept -> bool { return index == other.index; }
+            auto operator!=(const iterator& other) const noexcept -> bool { return index != other.index; }
+        };
+
+        mapped_column() noexcept = default;
+
+        mapped_column(mapped_column&& other) noexcept { swap(other); }
+
+        auto operator=(mapped_column&& other) noexcept -> mapped_column& {
+            mapped_column{std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        ~mapped_column() {
+            if (base != nullptr) ::munmap(const_cast<std::byte*>(base), length);
+        }
+
+        static auto open(const char* path) -> maybe<mapped_column> {
+            auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return std::nullopt;
+            struct stat info {};
+            void* mapped = MAP_FAILED;
+            if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(column_header))
+                mapped = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapped == MAP_FAILED) return std::nullopt;
+
+            auto column = mapped_column{};
+            column.base = static_cast<const std::byte*>(mapped);
+            column.length = static_cast<std::size_t>(info.st_size);
+            if (!column.attach()) return std::nullopt;
+            return maybe<mapped_column>{std::move(column)};
+        }
+
+        auto size() const noexcept -> size_type { return rows; }
+        auto empty() const noexcept -> bool { return rows == 0; }
+
+        auto count() const noexcept -> size_type {
+            auto total = size_type{0};
+            for (size_type i = 0; i < detail::column_words(rows); ++i)
+                total += static_cast<size_type>(__builtin_popcountll(validity[i]));
+            return total;
+        }
+
+        auto operator[](size_type index) const noexcept -> value_type {
+            if ((validity[index / 64] & (std::uint64_t{1} << (index % 64))) == 0) return std::nullopt;
+            if constexpr (text) {
+                auto first = std::min<std::size_t>(offsets[index], characters);
+                auto last = std::clamp<std::size_t>(offsets[index + 1], first, characters);
+                return value_type{std::string_view{reinterpret_cast<const char*>(values) + first, last - first}};
+            } else {
+                return value_type{data()[index]};
+            }
+        }
+
+        auto begin() const noexcept -> iterator { return {this, 0}; }
+        auto end() const noexcept -> iterator { return {this, rows}; }
+
+        auto data() const noexcept -> const T* {
+            static_assert(!text, "string columns have no fixed-width data()");
+            return std::launder(reinterpret_cast<const T*>(values));
+        }
+        auto bitmap() const noexcept -> const std::uint64_t* { return validity; }
+
+        auto swap(mapped_column& other) noexcept -> void {
+            std::swap(base, other.base);
+            std::swap(length, other.length);
+            std::swap(rows, other.rows);
+            std::swap(validity, other.validity);
+            std::swap(values, other.values);
+            std::swap(offsets, other.offsets);
+            std::swap(characters, other.characters);
+        }
+
+    private:
+        auto region(std::uint64_t offset, std::uint64_t size) const noexcept -> const std::byte* {
+            if (offset % detail::column_alignment != 0 || offset > length || size > length - offset) return nullptr;
+            return base + offset;
+        }
+
+        auto attach() noexcept -> bool {
+            auto header = column_header{};
+            std::memcpy(&header, base, sizeof header);
+            auto kind = text ? detail::column_kind::text : detail::column_kind::fixed;
+            if (std::memcmp(header.magic, detail::column_magic, sizeof header.magic) != 0 ||
+                header.kind != static_cast<std::uint32_t>(kind) || header.value_size != (text ? 1 : sizeof(T)) ||
+                header.bytes != length || header.rows > length * 8)
+                return false;
+
+            rows = header.rows;
+            auto words = detail::column_words(rows);
+            validity = reinterpret_cast<const std::uint64_t*>(region(header.validity, words * sizeof(std::uint64_t)));
+            if constexpr (text) {
+                offsets = reinterpret_cast<const std::uint64_t*>(region(header.offsets, (rows + 1) * sizeof(std::uint64_t)));
+                values = region(header.values, 0);
+                if (offsets == nullptr || values == nullptr) return false;
+                characters = length - header.values;
+            } else {
+                values = region(header.values, rows * sizeof(T));
+            }
+            return validity != nullptr && values != nullptr;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef HAN_COLUMNS_HH
+#define HAN_COLUMNS_HH
+#include <han/maybe_vector.hh>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAN_COLUMNS_X86 1
+#else
+#define HAN_COLUMNS_X86 0
+#endif
+
+namespace han::columns {
+    enum class isa { scalar, sse2, avx2, avx512 };
+
+    inline auto supported(isa level) noexcept -> bool {
+#if HAN_COLUMNS_X86
+        switch (level) {
+        case isa::scalar: return true;
+        case isa::sse2: return __builtin_cpu_supports("sse2");
+        case isa::avx2: return __builtin_cpu_supports("avx2");
+        case isa::avx512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+        }
+        return false;
+#else
+        return level == isa::scalar;
+#endif
+    }
+
+    inline auto best() noexcept -> isa {
+        static const auto level = [] {
+            for (auto candidate : {isa::avx512, isa::avx2, isa::sse2})
+                if (supported(candidate)) return candidate;
+            return isa::scalar;
+        }();
+        return level;
+    }
+
+    namespace detail {
+        using word_type = std::uint64_t;
+        constexpr std::size_t word_bits = 64;
+        constexpr word_type full = ~word_type{0};
+
+        // An unsigned integer as wide as T, so that selecting between two
+        // T by a lane of these vectorizes without widening.
+        template <std::size_t Size>
+        struct lane_for;
+        template <> struct lane_for<1> { using type = std::uint8_t; };
+        template <> struct lane_for<2> { using type = std::uint16_t; };
+        template <> struct lane_for<4> { using type = std::uint32_t; };
+        template <> struct lane_for<8> { using type = std::uint64_t; };
+
+        template <typename T>
+        using lane_t = typename lane_for<sizeof(T)>::type;
+
+        template <typename T>
+        inline constexpr bool blendable_v =
+            std::is_arithmetic_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+        // One lane per slot, 1 where the bit is set.
+        template <typename Lane>
+        [[gnu::always_inline]] inline auto expand(word_type word, Lane* present) noexcept -> void {
+            for (std::size_t group = 0; group < word_bits / 8; ++group) {
+                auto bits = (word >> (group * 8)) & 0xff;
+                auto bytes = __builtin_bswap64(((bits * 0x8040'2010'0804'0201) >> 7) & 0x0101'0101'0101'0101);
+                unsigned char spread[8];
+                std::memcpy(spread, &bytes, sizeof bytes);
+                for (std::size_t i = 0; i < 8; ++i) present[group * 8 + i] = spread[i];
+            }
+        }
+
+        [[gnu::always_inline]] inline auto pack(const unsigned char* keep) noexcept -> word_type {
+            auto mask = word_type{0};
+            for (std::size_t group = 0; group < word_bits / 8; ++group) {
+                auto bytes = word_type{0};
+                for (std::size_t i = 0; i < 8; ++i) bytes |= word_type{keep[group * 8 + i]} << (i * 8);
+                mask |= ((bytes * 0x0102040810204080) >> 56) << (group * 8);
+            }
+            return mask;
+        }
+
+        // Words with every slot present run the callable over all of them.
+        // In partial words each absent slot is replaced by the first present
+        // value of the word before the callable runs, and keeps its old
+        // contents afterwards: the loops stay branch-free, and the callable
+        // still only ever sees values that are present, so a division by the
+        // zero an absent slot holds can't trap.
+        template <typename T, typename C>
+        [[gnu::always_inline]] inline auto transform_full_word(T* values, C& code) -> void {
+            for (std::size_t i = 0; i < word_bits; ++i) values[i] = code(values[i]);
+        }
+
+        template <typename T, typename C>
+        [[gnu::always_inline]] inline auto transform_partial_word(T* values, word_type word, C& code) -> void {
+            lane_t<T> present[word_bits];
+            T out[word_bits];
+            expand(word, present);
+            const auto fill = values[__builtin_ctzll(word)];
+            for (std::size_t i = 0; i < word_bits; ++i) {
+                const auto value = values[i];
+                out[i] = code(present[i] != 0 ? value : fill);
+            }
+            for (std::size_t i = 0; i < word_bits; ++i) {
+                const auto value = values[i];
+                const auto result = out[i];
+                values[i] = present[i] != 0 ? result : value;
+            }
+        }
+
+        // The last word of a column may hold fewer than 64 slots, and
+        // reading past them would leave the buffer.
+        template <typename T, typename C>
+        [[gnu::always_inline]] inline auto transform_present(T* values, word_type word, C& code) -> void {
+            for (; word != 0; word &= word - 1) {
+                auto i = static_cast<std::size_t>(__builtin_ctzll(word));
+                values[i] = code(values[i]);
+            }
+        }
+
+        template <typename T, typename P>
+        [[gnu::always_inline]] inline auto filter_full_word(const T* values, P& predicate) -> word_type {
+            unsigned char keep[word_bits];
+            for (std::size_t i = 0; i < word_bits; ++i) keep[i] = predicate(values[i]) ? 1 : 0;
+            return pack(keep);
+        }
+
+        template <typename T, typename P>
+        [[gnu::always_inline]] inline auto filter_partial_word(const T* values, word_type word, P& predicate) -> word_type {
+            lane_t<T> present[word_bits];
+            unsigned char keep[word_bits];
+            expand(word, present);
+            const auto fill = values[__builtin_ctzll(word)];
+            for (std::size_t i = 0; i < word_bits; ++i) {
+                const auto value = values[i];
+                keep[i] = predicate(present[i] != 0 ? value : fill) ? 1 : 0;
+            }
+            return word & pack(keep);
+        }
+
+        template <typename T, typename P>
+        [[gnu::always_inline]] inline auto filter_present(const T* values, word_type word, P& predicate) -> word_type {
+            for (auto bits = word; bits != 0; bits &= bits - 1) {
+                auto i = static_cast<std::size_t>(__builtin_ctzll(bits));
+                if (!predicate(values[i])) word &= ~(word_type{1} << i);
+            }
+            return word;
+        }
+
+        // Bits past the end of the column are never set.
+        template <typename T, typename C>
+        [[gnu::always_inline]] inline auto transform_words(T* values, const word_type* bitmap, std::size_t size, C& code) -> void {
+            for (std::size_t w = 0; w * word_bits < size; ++w) {
+                if (bitmap[w] == 0) continue;
+                if (bitmap[w] == full) transform_full_word(values + w * word_bits, code);
+                else if (size - w * word_bits < word_bits) transform_present(values + w * word_bits, bitmap[w], code);
+                else if constexpr (blendable_v<T>) transform_partial_word(values + w * word_bits, bitmap[w], code);
+                else transform_present(values + w * word_bits, bitmap[w], code);
+            }
+        }
+
+        template <typename T, typename P>
+        [[gnu::always_inline]] inline auto filter_words(const T* values, word_type* bitmap, std::size_t size, P& predicate) -> void {
+            for (std::size_t w = 0; w * word_bits < size; ++w) {
+                if (bitmap[w] == 0) continue;
+                if (bitmap[w] == full) bitmap[w] = filter_full_word(values + w * word_bits, predicate);
+                else if (size - w * word_bits < word_bits) bitmap[w] = filter_present(values + w * word_bits, bitmap[w], predicate);
+                else if constexpr (blendable_v<T>) bitmap[w] = filter_partial_word(values + w * word_bits, bitmap[w], predicate);
+                else bitmap[w] = filter_present(values + w * word_bits, bitmap[w], predicate);
+            }
+        }
+
+        template <typename T, typename C>
+        auto transform_scalar(T* values, const word_type* bitmap, std::size_t size, C& code) -> void {
+            for (std::size_t i = 0; i < size; ++i)
+                if (((bitmap[i / word_bits] >> (i % word_bits)) & 1) != 0) values[i] = code(values[i]);
+        }
+
+        template <typename T, typename P>
+        auto filter_scalar(const T* values, word_type* bitmap, std::size_t size, P& predicate) -> void {
+            for (std::size_t i = 0; i < size; ++i) {
+                auto bit = word_type{1} << (i % word_bits);
+                if ((bitmap[i / word_bits] & bit) != 0 && !predicate(values[i])) bitmap[i / word_bits] &= ~bit;
+            }
+        }
+
+#if HAN_COLUMNS_X86
+        template <typename T, typename C>
+        [[gnu::target("sse2")]] auto transform_sse2(T* values, const word_type* bitmap, std::size_t size, C& code) -> void {
+            transform_words(values, bitmap, size, code);
+        }
+
+        template <typename T, typename C>
+        [[gnu::target("avx2")]] auto transform_avx2(T* values, const word_type* bitmap, std::size_t size, C& code) -> void {
+            transform_words(values, bitmap, size, code);
+        }
+
+        template <typename T, typename C>
+        [[gnu::target("avx512f,avx512bw")]] auto transform_avx512(T* values, const word_type* bitmap, std::size_t size, C& code) -> void {
+            transform_words(values, bitmap, size, code);
+        }
+
+        template <typename T, typename P>
+        [[gnu::target("sse2")]] auto filter_sse2(const T* values, word_type* bitmap, std::size_t size, P& predicate) -> void {
+            filter_words(values, bitmap, size, predicate);
+        }
+
+        template <typename T, typename P>
+        [[gnu::target("avx2")]] auto filter_avx2(const T* values, word_type* bitmap, std::size_t size, P& predicate) -> void {
+            filter_words(values, bitmap, size, predicate);
+        }
+
+        template <typename T, typename P>
+        [[gnu::target("avx512f,avx512bw")]] auto filter_avx512(const T* values, word_type* bitmap, std::size_t size, P& predicate) -> void {
+            filter_words(values, bitmap, size, predicate);
+        }
+#endif
+    }
+
+    template <typename T, typename C>
+    auto transform(maybe_vector<T>& column, C code, isa level = best()) -> void {
+        static_assert(std::is_arithmetic_v<T> && std::is_same_v<std::invoke_result_t<C&, T&>, T>,
+                      "columns::transform() needs a column of numbers and a T(T) callable");
+        auto* values = column.data();
+        const auto* bitmap = column.bitmap();
+        auto size = column.size();
+        if (!supported(level)) level = isa::scalar;
+        switch (level) {
+#if HAN_COLUMNS_X86
+        case isa::avx512: return detail::transform_avx512(values, bitmap, size, code);
+        case isa::avx2: return detail::transform_avx2(values, bitmap, size, code);
+        case isa::sse2: return detail::transform_sse2(values, bitmap, size, code);
+#else
+        case isa::avx512:
+        case isa::avx2:
+        case isa::sse2:
+#endif
+        case isa::scalar: return detail::transform_scalar(values, bitmap, size, code);
+        }
+    }
+
+    template <typename T, typename P>
+    auto filter(maybe_vector<T>& column, P predicate, isa level = best()) -> void {
+        const auto* values = column.data();
+        auto* bitmap = column.bitmap();
+        auto size = column.size();
+        if (!supported(level)) level = isa::scalar;
+        switch (level) {
+#if HAN_COLUMNS_X86
+        case isa::avx512: return detail::filter_avx512(values, bitmap, size, predicate);
+        case isa::avx2: return detail::filter_avx2(values, bitmap, size, predicate);
+        case isa::sse2: return detail::filter_sse2(values, bitmap, size, predicate);
+#else
+        case isa::avx512:
+        case isa::avx2:
+        case isa::sse2:
+#endif
+        case isa::scalar: return detail::filter_scalar(values, bitmap, size, predicate);
+        }
+    }
+}
+
+#endif
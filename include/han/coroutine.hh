@@ -0,0 +1,226 @@
+#ifndef HAN_COROUTINE_HH
+#define HAN_COROUTINE_HH
+#include <han/maybe.hh>
+
+// maybe-returning coroutines need C++20; in C++17 this header is empty.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace han {
+    namespace detail {
+        // Frames are allocated with a deleter stored after them, followed by
+        // a copy of the allocator if the coroutine was given one.
+        class frame_storage {
+            using deleter = void (*)(void*, std::size_t) noexcept;
+
+            struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) block {
+                std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+            };
+
+            template <typename A>
+            using block_allocator = typename std::allocator_traits<A>::template rebind_alloc<block>;
+
+            constexpr static auto align(std::size_t offset, std::size_t alignment) noexcept -> std::size_t {
+                return (offset + alignment - 1) / alignment * alignment;
+            }
+
+            constexpr static auto deleter_offset(std::size_t size) noexcept -> std::size_t {
+                return align(size, alignof(deleter));
+            }
+
+            template <typename A>
+            constexpr static auto allocator_offset(std::size_t size) noexcept -> std::size_t {
+                return align(deleter_offset(size) + sizeof(deleter), alignof(A));
+            }
+
+            template <typename A>
+            constexpr static auto blocks(std::size_t size) noexcept -> std::size_t {
+                return (allocator_offset<A>(size) + sizeof(A) + sizeof(block) - 1) / sizeof(block);
+            }
+
+            template <typename A>
+            static auto deallocate(void* frame, std::size_t size) noexcept -> void {
+                auto stored = std::launder(reinterpret_cast<A*>(static_cast<std::byte*>(frame) + allocator_offset<A>(size)));
+                auto alloc = A(std::move(*stored));
+                stored->~A();
+                std::allocator_traits<A>::deallocate(alloc, static_cast<block*>(frame), blocks<A>(size));
+            }
+
+        protected:
+            template <typename Alloc>
+            static auto allocate(std::size_t size, const Alloc& original) -> void* {
+                using A = block_allocator<Alloc>;
+                auto alloc = A(original);
+                void* frame = std::to_address(std::allocator_traits<A>::allocate(alloc, blocks<A>(size)));
+                auto bytes = static_cast<std::byte*>(frame);
+                const auto release = deleter{&deallocate<A>};
+                std::memcpy(bytes + deleter_offset(size), &release, sizeof release);
+                ::new (static_cast<void*>(bytes + allocator_offset<A>(size))) A(std::move(alloc));
+                return frame;
+            }
+
+            static auto free_frame(void* frame, std::size_t size) noexcept -> void {
+                auto release = deleter{};
+                std::memcpy(&release, static_cast<std::byte*>(frame) + deleter_offset(size), sizeof release);
+                release(frame, size);
+            }
+
+        public:
+            static auto operator new(std::size_t size) -> void* {
+                return allocate(size, std::allocator<block>{});
+            }
+
+            static auto operator delete(void* frame, std::size_t size) noexcept -> void {
+                free_frame(frame, size);
+            }
+        };
+
+        // A coroutine takes an allocator as (std::allocator_arg, alloc, ...)
+        // leading its parameters, or right after the object of a member
+        // function. Returns the allocator's position, or 0 for none.
+        template <typename... Args>
+        constexpr auto allocator_position() noexcept -> std::size_t {
+            constexpr bool tag[] = {std::is_same_v<std::remove_cv_t<std::remove_reference_t<Args>>, std::allocator_arg_t>..., false, false};
+            if (sizeof...(Args) >= 2 && tag[0]) return 1;
+            if (sizeof...(Args) >= 3 && tag[1]) return 2;
+            return 0;
+        }
+
+        // The allocating operator new takes exactly the coroutine's
+        // parameters, so it is not a template and pairs with the usual
+        // operator delete.
+        template <std::size_t Position, typename... Args>
+        class frame_allocation : public frame_storage {
+        public:
+            using frame_storage::operator new;
+
+            static auto operator new(std::size_t size, const std::remove_reference_t<Args>&... args) -> void* {
+                return allocate(size, std::get<Position>(std::forward_as_tuple(args...)));
+            }
+
+            static auto operator delete(void* frame, std::size_t size) noexcept -> void {
+                free_frame(frame, size);
+            }
+        };
+
+        template <typename... Args>
+        class frame_allocation<0, Args...> : public frame_storage {};
+
+        template <typename T>
+        class maybe_promise;
+
+        // What the coroutine returns until it finishes. The promise writes
+        // the value straight into it, so the two keep pointers to each other
+        // for as long as both are alive.
+        template <typename T>
+        class maybe_return {
+            maybe<T> value;
+            maybe_promise<T>* promise;
+
+            friend class maybe_promise<T>;
+
+        public:
+            explicit maybe_return(maybe_promise<T>& p) noexcept: promise(&p) { p.out = this; }
+
+            maybe_return(maybe_return&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+                : value(std::move(other.value)), promise(std::exchange(other.promise, nullptr)) {
+                if (promise != nullptr) promise->out = this;
+            }
+
+            maybe_return(const maybe_return&) = delete;
+            auto operator=(const maybe_return&) -> maybe_return& = delete;
+
+            ~maybe_return() {
+                if (promise != nullptr) promise->out = nullptr;
+            }
+
+            operator maybe<T>() noexcept(std::is_nothrow_move_constructible_v<T>) {
+                return std::move(value);
+            }
+        };
+
+        // co_await on an lvalue gives a reference into it, on an rvalue the
+        // moved value. An empty maybe destroys the coroutine, which leaves
+        // its result empty.
+        template <typename M>
+        class maybe_awaiter {
+            M&& m;
+
+        public:
+            explicit maybe_awaiter(M&& m_) noexcept: m(std::forward<M>(m_)) {}
+
+            auto await_ready() const noexcept -> bool { return access::has_value(m); }
+
+            auto await_suspend(std::coroutine_handle<> coroutine) const noexcept -> void { coroutine.destroy(); }
+
+            auto await_resume() const noexcept(std::is_lvalue_reference_v<M> || std::is_nothrow_move_constructible_v<payload_t<M>>)
+                -> std::conditional_t<std::is_lvalue_reference_v<M>, forwarded_t<M>, payload_t<M>> {
+                return access::value(std::forward<M>(m));
+            }
+        };
+
+        template <typename T>
+        class maybe_promise {
+            static_assert(!std::is_reference_v<T>, "maybe<T&> can't be returned from a coroutine");
+
+            maybe_return<T>* out = nullptr;
+
+            friend class maybe_return<T>;
+
+        public:
+            maybe_promise() noexcept = default;
+            maybe_promise(const maybe_promise&) = delete;
+            auto operator=(const maybe_promise&) -> maybe_promise& = delete;
+
+            ~maybe_promise() {
+                if (out != nullptr) out->promise = nullptr;
+            }
+
+            auto get_return_object() noexcept -> maybe_return<T> { return maybe_return<T>{*this}; }
+
+            auto initial_suspend() const noexcept -> std::suspend_never { return {}; }
+            auto final_suspend() const noexcept -> std::suspend_never { return {}; }
+
+            template <typename U = T>
+            auto return_value(U&& value)
+                noexcept(std::is_same_v<std::decay_t<U>, std::nullopt_t> ||
+                         (std::is_same_v<std::decay_t<U>, maybe<T>> ? std::is_nothrow_assignable_v<maybe<T>&, U>
+                                                                    : is_nothrow_emplaceable_v<T, U>)) -> void {
+                if constexpr (std::is_same_v<std::decay_t<U>, std::nullopt_t>) static_cast<void>(value);
+                else if constexpr (std::is_same_v<std::decay_t<U>, maybe<T>>) out->value = std::forward<U>(value);
+                else out->value.emplace(std::forward<U>(value));
+            }
+
+            template <typename M,
+                      typename = std::enable_if_t<is_maybe_v<std::remove_cv_t<std::remove_reference_t<M>>>>>
+            auto await_transform(M&& m) const noexcept -> maybe_awaiter<M> {
+                return maybe_awaiter<M>{std::forward<M>(m)};
+            }
+
+            [[noreturn]] auto unhandled_exception() const -> void {
+#if defined(__cpp_exceptions)
+                throw;
+#else
+                std::terminate();
+#endif
+            }
+        };
+    }
+}
+
+template <typename T, typename... Args>
+struct std::coroutine_traits<han::maybe<T>, Args...> {
+    class promise_type : public han::detail::maybe_promise<T>,
+                         public han::detail::frame_allocation<han::detail::allocator_position<Args...>(), Args...> {};
+};
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef HAN_FIRST_PRESENT_HH
+#define HAN_FIRST_PRESENT_HH
+#include <han/future.hh>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace han {
+    // Tells an alternative of first_present() that its result can no longer
+    // be picked, so it may give up early.
+    class cancel_token {
+        const std::atomic<std::size_t>* best;
+        std::size_t index;
+
+    public:
+        cancel_token(const std::atomic<std::size_t>& best_, std::size_t index_) noexcept: best(&best_), index(index_) {}
+
+        auto cancelled() const noexcept -> bool { return best->load(std::memory_order_relaxed) < index; }
+    };
+
+    namespace detail {
+        // Alternative i is finished once it has returned or thrown. The
+        // answer is the first finished alternative that isn't empty, once
+        // all of those before it are finished and empty.
+        template <typename T, std::size_t N>
+        class race_state {
+            std::mutex lock;
+            std::array<maybe<T>, N> results;
+            std::array<std::exception_ptr, N> errors;
+            std::array<bool, N> finished{};
+            std::size_t first_unknown = 0;
+            bool decided = false;
+            std::shared_ptr<future_state<T>> out = std::make_shared<future_state<T>>();
+
+        public:
+            // The lowest index that returned a value or threw; everything
+            // after it is cancelled. Once decided, everything is.
+            std::atomic<std::size_t> best{N};
+
+            auto future() -> maybe_future<T> { return future_access::make(out); }
+
+            auto report(std::size_t i, maybe<T>&& result, std::exception_ptr failure) -> void {
+                auto answer = maybe<T>{};
+                auto error = std::exception_ptr{};
+                {
+                    auto guard = std::lock_guard{lock};
+                    if (decided) return;
+                    results[i] = std::move(result);
+                    errors[i] = std::move(failure);
+                    finished[i] = true;
+                    if (errors[i] || access::has_value(results[i]))
+                        if (i < best.load(std::memory_order_relaxed)) best.store(i, std::memory_order_relaxed);
+                    while (first_unknown < N && finished[first_unknown] && !errors[first_unknown] &&
+                           !access::has_value(results[first_unknown]))
+                        ++first_unknown;
+                    if (first_unknown < N && !finished[first_unknown]) return;
+                    if (first_unknown < N) {
+                        answer = std::move(results[first_unknown]);
+                        error = std::move(errors[first_unknown]);
+                    }
+                    decided = true;
+                    best.store(0, std::memory_order_relaxed);
+                }
+                out->finish(std::move(answer), std::move(error));
+            }
+        };
+
+        template <typename F>
+        auto run_alternative(F& code, const cancel_token& token) {
+            if constexpr (std::is_invocable_v<F&, const cancel_token&>) return detail::invoke(code, token);
+            else return detail::invoke(code);
+        }
+
+        template <typename F>
+        using alternative_result_t = std::decay_t<decltype(run_alternative(std::declval<F&>(), std::declval<const cancel_token&>()))>;
+    }
+
+    // Starts every alternative on the pool at once and gives the value of
+    // the first one, in argument order, that isn't empty. It is ready as
+    // soon as that alternative and all of those before it have returned, so
+    // a miss costs the latency of the slowest alternative that had to be
+    // asked instead of the sum of all of them. Alternatives that haven't
+    // started by then are skipped; one that takes a cancel_token can check
+    // it to stop early.
+    template <typename F, typename... Fs>
+    auto first_present(thread_pool& pool, F&& alternative, Fs&&... alternatives)
+        -> maybe_future<detail::payload_t<detail::alternative_result_t<std::decay_t<F>>>> {
+        using M = detail::alternative_result_t<std::decay_t<F>>;
+        static_assert(detail::is_maybe_v<M>, "first_present() needs callables returning a maybe");
+        static_assert((std::is_same_v<detail::alternative_result_t<std::decay_t<Fs>>, M> && ...),
+                      "all alternatives of first_present() must return the same type of maybe");
+        using T = detail::payload_t<M>;
+        constexpr auto n = 1 + sizeof...(Fs);
+
+        auto state = std::make_shared<detail::race_state<T, n>>();
+        auto result = state->future();
+        auto start = [&](std::size_t i, auto&& code) {
+            pool.submit([state, i, code = std::forward<decltype(code)>(code)]() mutable {
+                auto token = cancel_token{state->best, i};
+                if (token.cancelled()) return;
+#if defined(__cpp_exceptions)
+                try {
+                    state->report(i, detail::run_alternative(code, token), {});
+                } catch (...) {
+                    state->report(i, std::nullopt, std::current_exception());
+                }
+#else
+                state->report(i, detail::run_alternative(code, token), {});
+#endif
+            });
+        };
+        auto i = std::size_t{0};
+        start(i++, std::forward<F>(alternative));
+        (start(i++, std::forward<Fs>(alternatives)), ...);
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef HAN_FUTURE_HH
+#define HAN_FUTURE_HH
+#include <han/maybe.hh>
+#include <han/thread_pool.hh>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace han {
+    template <typename T>
+    class maybe_future;
+
+    namespace detail {
+        template <typename T>
+        constexpr bool is_maybe_future_v = false;
+
+        template <typename T>
+        constexpr bool is_maybe_future_v<maybe_future<T>> = true;
+
+        template <typename T>
+        class future_state;
+
+        // For code in this namespace that creates futures or reaches into
+        // their state.
+        struct future_access {
+            template <typename T>
+            static auto make(std::shared_ptr<future_state<T>> state) noexcept -> maybe_future<T> {
+                return maybe_future<T>{std::move(state)};
+            }
+
+            template <typename T>
+            static auto state(maybe_future<T>&& future) noexcept -> std::shared_ptr<future_state<T>> {
+                return std::move(future.state);
+            }
+        };
+
+        // Written once by whoever finishes it and read only after that, so
+        // the value itself needs no lock. A single continuation runs right
+        // after the value is set, on the thread that set it.
+        template <typename T>
+        class future_state {
+            std::mutex lock;
+            std::condition_variable done;
+            bool finished = false;
+            maybe<T> value;
+            std::exception_ptr error;
+            std::function<void()> continuation;
+
+        public:
+            auto finish(maybe<T>&& result, std::exception_ptr failure = {}) -> void {
+                auto next = std::function<void()>{};
+                {
+                    auto guard = std::lock_guard{lock};
+                    value = std::move(result);
+                    error = std::move(failure);
+                    finished = true;
+                    next = std::move(continuation);
+                }
+                done.notify_all();
+                if (next) next();
+            }
+
+            // Runs now if the value is there, otherwise when it arrives.
+            template <typename F>
+            auto then(F&& code) -> void {
+                {
+                    auto guard = std::lock_guard{lock};
+                    if (!finished) {
+                        continuation = std::forward<F>(code);
+                        return;
+                    }
+                }
+                code();
+            }
+
+            auto ready() noexcept -> bool {
+                auto guard = std::lock_guard{lock};
+                return finished;
+            }
+
+            auto wait() -> void {
+                auto guard = std::unique_lock{lock};
+                done.wait(guard, [this] { return finished; });
+            }
+
+            // Only after ready() or wait().
+            auto result() const& -> const maybe<T>& {
+                if (error) std::rethrow_exception(error);
+                return value;
+            }
+
+            auto result() && -> maybe<T> {
+                if (error) std::rethrow_exception(error);
+                return std::move(value);
+            }
+
+            auto failure() const noexcept -> const std::exception_ptr& { return error; }
+        };
+
+        // Finishes `state` with what `produce` returns: a maybe, or a
+        // maybe_future whose value is forwarded when it arrives.
+        template <typename T, typename F>
+        auto settle(const std::shared_ptr<future_state<T>>& state, F&& produce) -> void {
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                auto produced = std::forward<F>(produce)();
+                if constexpr (is_maybe_future_v<decltype(produced)>) {
+                    auto inner = future_access::state(std::move(produced));
+                    inner->then([inner, state] {
+                        if (inner->failure()) state->finish(std::nullopt, inner->failure());
+                        else state->finish(std::move(*inner).result());
+                    });
+                } else {
+                    state->finish(std::move(produced));
+                }
+#if defined(__cpp_exceptions)
+            } catch (...) {
+                state->finish(std::nullopt, std::current_exception());
+            }
+#endif
+        }
+
+        template <typename R>
+        struct future_value {
+            using type = R;
+        };
+
+        template <typename R>
+        struct future_value<maybe<R>> {
+            using type = R;
+        };
+
+        template <typename R>
+        struct future_value<maybe_future<R>> {
+            using type = R;
+        };
+
+        template <typename R>
+        using future_value_t = typename future_value<std::remove_cv_t<std::remove_reference_t<R>>>::type;
+    }
+
+    template <typename T>
+    class maybe_future {
+        std::shared_ptr<detail::future_state<T>> state;
+
+        template <typename> friend class maybe_future;
+        friend struct detail::future_access;
+
+        explicit maybe_future(std::shared_ptr<detail::future_state<T>> s) noexcept: state(std::move(s)) {}
+
+        // The next future in a chain, finished by `step` once this one is.
+        template <typename U, typename S>
+        auto chain(S step) && -> maybe_future<U> {
+            auto next = std::make_shared<detail::future_state<U>>();
+            auto from = std::move(state);
+            from->then([from, next, step = std::move(step)]() mutable {
+                if (from->failure()) next->finish(std::nullopt, from->failure());
+                else detail::settle(next, [&] { return step(std::move(*from).result()); });
+            });
+            return maybe_future<U>{std::move(next)};
+        }
+
+    public:
+        using value_type = T;
+
+        maybe_future(maybe<T> value) : state(std::make_shared<detail::future_state<T>>()) {
+            state->finish(std::move(value));
+        }
+
+        maybe_future(std::nullopt_t) : maybe_future(maybe<T>{}) {}
+
+        // The state holds a single continuation, so only one chain may
+        // follow a future.
+        maybe_future(maybe_future&&) noexcept = default;
+        maybe_future(const maybe_future&) = delete;
+        auto operator=(maybe_future&&) noexcept -> maybe_future& = default;
+        auto operator=(const maybe_future&) -> maybe_future& = delete;
+
+        template <typename F>
+        static auto run(thread_pool& pool, F&& code) -> maybe_future {
+            auto s = std::make_shared<detail::future_state<T>>();
+            pool.submit([s, code = std::forward<F>(code)]() mutable {
+                detail::settle(s, [&] {
+                    using R = decltype(detail::invoke(code));
+                    if constexpr (detail::is_maybe_v<R> || detail::is_maybe_future_v<R>) return detail::invoke(code);
+                    else return maybe<T>{detail::invoke(code)};
+                });
+            });
+            return maybe_future{std::move(s)};
+        }
+
+        auto ready() const -> bool { return state->ready(); }
+
+        // The value, if it is already there; never blocks.
+        auto try_get() const -> maybe<T> {
+            if (!state->ready()) return std::nullopt;
+            return state->result();
+        }
+
+        auto wait() const -> void { state->wait(); }
+
+        auto get() && -> maybe<T> {
+            state->wait();
+            return std::move(*state).result();
+        }
+
+        template <typename C>
+        auto then_do(C&& code) && {
+            using M = decltype(std::declval<maybe<T>>().then_do(code));
+            return std::move(*this).template chain<detail::payload_t<M>>(
+                [code = std::forward<C>(code)](maybe<T>&& m) mutable { return std::move(m).then_do(code); });
+        }
+
+        template <typename C>
+        auto then_maybe(C&& code) && {
+            using R = detail::invoke_result_t<C&, T>;
+            static_assert(detail::is_maybe_v<R> || detail::is_maybe_future_v<R>,
+                          "then_maybe() needs a callable returning a maybe or a maybe_future");
+            return std::move(*this).template chain<detail::future_value_t<R>>(
+                [code = std::forward<C>(code)](maybe<T>&& m) mutable -> R {
+                    if (detail::access::has_value(m)) return detail::invoke(code, detail::access::value(std::move(m)));
+                    else return R{std::nullopt};
+                });
+        }
+
+        template <typename C>
+        auto or_maybe(C&& code) && -> maybe_future<T> {
+            using R = detail::invoke_result_t<C&>;
+            static_assert(std::is_same_v<R, maybe<T>> || std::is_same_v<R, maybe_future<T>>,
+                          "or_maybe() needs a callable returning a maybe<T> or a maybe_future<T>");
+            return std::move(*this).template chain<T>([code = std::forward<C>(code)](maybe<T>&& m) mutable -> R {
+                if (detail::access::has_value(m)) return R{std::move(m)};
+                else return detail::invoke(code);
+            });
+        }
+    };
+
+    // Runs `code` on the pool. It may return a T, a maybe<T> or a
+    // maybe_future<T>.
+    template <typename F>
+    auto async(thread_pool& pool, F&& code) -> maybe_future<detail::future_value_t<detail::invoke_result_t<std::decay_t<F>&>>> {
+        using T = detail::future_value_t<detail::invoke_result_t<std::decay_t<F>&>>;
+        return maybe_future<T>::run(pool, std::forward<F>(code));
+    }
+}
+
+#endif
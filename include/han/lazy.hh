@@ -0,0 +1,149 @@
+#ifndef HAN_LAZY_HH
+#define HAN_LAZY_HH
+#include <han/maybe.hh>
+#include <tuple>
+#include <utility>
+
+namespace han {
+    namespace detail {
+        template <typename C>
+        struct then_do_stage {
+            C code;
+        };
+
+        template <typename C>
+        struct then_maybe_stage {
+            C code;
+        };
+    }
+
+    template <typename M, typename... Stages>
+    class lazy_maybe {
+        M source;
+        std::tuple<Stages...> stages;
+
+        template <typename, typename...> friend class lazy_maybe;
+
+    public:
+        template <typename S>
+        constexpr lazy_maybe(S&& source_, std::tuple<Stages...> stages_)
+            : source(std::forward<S>(source_)), stages(std::move(stages_)) {}
+
+        template <typename C>
+        constexpr auto then_do(C&& code) && {
+            return append(std::move(*this), detail::then_do_stage<std::decay_t<C>>{std::forward<C>(code)});
+        }
+
+        template <typename C>
+        constexpr auto then_do(C&& code) const& {
+            return append(*this, detail::then_do_stage<std::decay_t<C>>{std::forward<C>(code)});
+        }
+
+        template <typename C>
+        constexpr auto then_maybe(C&& code) && {
+            return append(std::move(*this), detail::then_maybe_stage<std::decay_t<C>>{std::forward<C>(code)});
+        }
+
+        template <typename C>
+        constexpr auto then_maybe(C&& code) const& {
+            return append(*this, detail::then_maybe_stage<std::decay_t<C>>{std::forward<C>(code)});
+        }
+
+        constexpr auto eval() && {
+            return std::forward<M>(source).then_maybe([&](auto&& value) {
+                return std::move(*this).template run<0>(std::forward<decltype(value)>(value));
+            });
+        }
+
+        constexpr auto eval() const& {
+            return lazy_maybe(*this).eval();
+        }
+
+        template <typename A>
+        constexpr auto or_else(A&& alt) && {
+            return std::move(*this).eval().or_else(std::forward<A>(alt));
+        }
+
+        template <typename A>
+        constexpr auto or_else(A&& alt) const& {
+            return eval().or_else(std::forward<A>(alt));
+        }
+
+        template <typename C>
+        constexpr auto or_else_do(C&& code) && {
+            return std::move(*this).eval().or_else_do(std::forward<C>(code));
+        }
+
+        template <typename C>
+        constexpr auto or_else_do(C&& code) const& {
+            return eval().or_else_do(std::forward<C>(code));
+        }
+
+        template <typename C>
+        constexpr auto or_maybe(C&& code) && {
+            return std::move(*this).eval().or_maybe(std::forward<C>(code));
+        }
+
+        template <typename C>
+        constexpr auto or_maybe(C&& code) const& {
+            return eval().or_maybe(std::forward<C>(code));
+        }
+
+    private:
+        template <typename L, typename S>
+        constexpr static auto append(L&& chain, S stage) {
+            return lazy_maybe<M, Stages..., S>{
+                std::forward<L>(chain).source,
+                std::tuple_cat(std::forward<L>(chain).stages, std::make_tuple(std::move(stage)))};
+        }
+
+        template <std::size_t I, typename V>
+        constexpr auto run(V&& value) && {
+            if constexpr (I == sizeof...(Stages)) {
+                return maybe<std::remove_cv_t<std::remove_reference_t<V>>>{std::forward<V>(value)};
+            } else {
+                auto& stage = std::get<I>(stages);
+                using stage_type = std::tuple_element_t<I, std::tuple<Stages...>>;
+                using code_type = decltype(stage.code);
+                if constexpr (std::is_same_v<stage_type, detail::then_maybe_stage<code_type>>) {
+                    auto next = detail::invoke(std::move(stage.code), std::forward<V>(value));
+                    if constexpr (I + 1 == sizeof...(Stages)) {
+                        return next;
+                    } else {
+                        return std::move(next).then_maybe([&](auto&& inner) {
+                            return std::move(*this).template run<I + 1>(std::forward<decltype(inner)>(inner));
+                        });
+                    }
+                } else if constexpr (std::is_void_v<detail::invoke_result_t<code_type, V&>>) {
+                    detail::invoke(std::move(stage.code), value);
+                    return std::move(*this).template run<I + 1>(std::forward<V>(value));
+                } else {
+                    using R = detail::invoke_result_t<code_type, V>;
+                    using X = std::remove_cv_t<std::remove_reference_t<R>>;
+                    if constexpr (has_niche_v<X> && !std::is_lvalue_reference_v<R>) {
+                        // As in maybe::then_do(), the niche value is no value.
+                        using result = decltype(std::move(*this).template run<I + 1>(std::declval<R>()));
+                        auto&& next = detail::invoke(std::move(stage.code), std::forward<V>(value));
+                        if (niche_traits<X>::is_empty(next)) return result{std::nullopt};
+                        return std::move(*this).template run<I + 1>(std::forward<decltype(next)>(next));
+                    } else {
+                        return std::move(*this).template run<I + 1>(
+                            detail::invoke(std::move(stage.code), std::forward<V>(value)));
+                    }
+                }
+            }
+        }
+    };
+
+    template <typename T>
+    constexpr auto lazy(const maybe<T>& source) -> lazy_maybe<const maybe<T>&> {
+        return {source, {}};
+    }
+
+    template <typename T>
+    constexpr auto lazy(maybe<T>&& source) -> lazy_maybe<maybe<T>> {
+        return {std::move(source), {}};
+    }
+}
+
+#endif
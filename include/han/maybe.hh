@@ -2,139 +2,746 @@
 #define HAN_MAYBE_HH
 #include <optional>
 #include <functional>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#define HAN_REQUIRES(...) requires (__VA_ARGS__)
+#else
+#define HAN_REQUIRES(...)
+#endif
 
 namespace han {
+    template <typename T, typename = void>
+    struct niche_traits {};
+
+    template <typename T, T Empty>
+    struct niche_value {
+        constexpr static auto empty() noexcept -> T { return Empty; }
+        constexpr static auto is_empty(const T& value) noexcept -> bool {
+            return value == Empty;
+        }
+    };
+
+    template <typename T>
+    struct niche_traits<T*> : niche_value<T*, nullptr> {};
+
+    template <>
+    struct niche_traits<double> {
+        constexpr static std::uint64_t pattern = 0x7ff8'6861'6e00'0000;
+
+        constexpr static auto empty() noexcept -> double {
+            return __builtin_bit_cast(double, pattern);
+        }
+        constexpr static auto is_empty(const double& value) noexcept -> bool {
+            return __builtin_bit_cast(std::uint64_t, value) == pattern;
+        }
+    };
+
+    template <>
+    struct niche_traits<float> {
+        constexpr static std::uint32_t pattern = 0x7fc8'616e;
+
+        constexpr static auto empty() noexcept -> float {
+            return __builtin_bit_cast(float, pattern);
+        }
+        constexpr static auto is_empty(const float& value) noexcept -> bool {
+            return __builtin_bit_cast(std::uint32_t, value) == pattern;
+        }
+    };
+
+    template <typename C, typename Traits>
+    struct niche_traits<std::basic_string_view<C, Traits>> {
+        constexpr static C sentinel[1] = {};
+
+        constexpr static auto empty() noexcept -> std::basic_string_view<C, Traits> {
+            return {sentinel, 0};
+        }
+        constexpr static auto is_empty(const std::basic_string_view<C, Traits>& value) noexcept -> bool {
+            return value.data() == sentinel;
+        }
+    };
+
+    template <typename T, typename = void>
+    constexpr bool has_niche_v = false;
+
+    template <typename T>
+    constexpr bool has_niche_v<T, std::void_t<decltype(niche_traits<T>::empty()),
+                                              decltype(niche_traits<T>::is_empty(std::declval<const T&>()))>> = true;
+
+    template <typename T>
+    class maybe;
+
+    namespace detail {
+        struct access;
+
+        template <typename T>
+        constexpr bool is_maybe_v = false;
+
+        template <typename T>
+        constexpr bool is_maybe_v<maybe<T>> = true;
+
+        template <bool MemberPointer>
+        struct invoke_traits {
+            template <typename C, typename... Args>
+            using result = decltype(std::declval<C>()(std::declval<Args>()...));
+
+            template <typename C, typename... Args>
+            constexpr static bool nothrow = noexcept(std::declval<C>()(std::declval<Args>()...));
+        };
+
+        template <>
+        struct invoke_traits<true> {
+            template <typename C, typename... Args>
+            using result = std::invoke_result_t<C, Args...>;
+
+            template <typename C, typename... Args>
+            constexpr static bool nothrow = std::is_nothrow_invocable_v<C, Args...>;
+        };
+
+        template <typename C>
+        using invoke_traits_for = invoke_traits<std::is_member_pointer_v<std::decay_t<C>>>;
+
+        template <typename C, typename... Args>
+        using invoke_result_t = typename invoke_traits_for<C>::template result<C, Args...>;
+
+        template <typename C, typename... Args>
+        constexpr bool is_nothrow_invocable_v = invoke_traits_for<C>::template nothrow<C, Args...>;
+
+        template <typename T>
+        constexpr bool is_reference_wrapper_v = false;
+
+        template <typename T>
+        constexpr bool is_reference_wrapper_v<std::reference_wrapper<T>> = true;
+
+        // std::invoke is only constexpr from C++20 on, so member pointers are
+        // dispatched here: on an object of the class, through a
+        // reference_wrapper, or through anything dereferenceable.
+        template <typename M, typename O>
+        constexpr auto member_object(O&& object) noexcept -> decltype(auto) {
+            using D = std::remove_cv_t<std::remove_reference_t<O>>;
+            if constexpr (std::is_base_of_v<M, D>) return std::forward<O>(object);
+            else if constexpr (is_reference_wrapper_v<D>) return object.get();
+            else return *std::forward<O>(object);
+        }
+
+        template <typename P, typename M, typename O, typename... Args>
+        constexpr auto invoke_member(P M::*member, O&& object, Args&&... args)
+            noexcept(std::is_nothrow_invocable_v<P M::*, O, Args...>) -> decltype(auto) {
+            if constexpr (std::is_member_function_pointer_v<P M::*>)
+                return (member_object<M>(std::forward<O>(object)).*member)(std::forward<Args>(args)...);
+            else
+                return (member_object<M>(std::forward<O>(object)).*member);
+        }
+
+        template <typename C, typename... Args>
+        constexpr auto invoke(C&& code, Args&&... args)
+            noexcept(is_nothrow_invocable_v<C, Args...>) -> decltype(auto) {
+            if constexpr (std::is_member_pointer_v<std::decay_t<C>>)
+                return invoke_member(code, std::forward<Args>(args)...);
+            else
+                return std::forward<C>(code)(std::forward<Args>(args)...);
+        }
+
+        // Calling a data member pointer on an rvalue gives T&&; the result is
+        // stored as a T.
+        template <typename R>
+        using then_result_t = std::conditional_t<std::is_rvalue_reference_v<R>, std::remove_cv_t<std::remove_reference_t<R>>, R>;
+
+        // A then_do() callable that returns nothing keeps the value, so it
+        // is given an lvalue even on an rvalue maybe.
+        template <typename C, typename V, typename = void>
+        constexpr bool is_void_on_lvalue_v = false;
+
+        template <typename C, typename V>
+        constexpr bool is_void_on_lvalue_v<C, V, std::enable_if_t<std::is_void_v<invoke_result_t<C, V&>>>> = true;
+
+        template <typename C, typename V>
+        using then_do_argument_t = std::conditional_t<is_void_on_lvalue_v<C, V>, V&, V>;
+
+        template <typename C, typename V, bool = is_void_on_lvalue_v<C, V>>
+        constexpr bool is_nothrow_then_do_v =
+            is_nothrow_invocable_v<C, V> &&
+            std::is_nothrow_constructible_v<maybe<then_result_t<invoke_result_t<C, V>>>, invoke_result_t<C, V>>;
+
+        template <typename C, typename V>
+        constexpr bool is_nothrow_then_do_v<C, V, true> =
+            is_nothrow_invocable_v<C, V&> && (std::is_reference_v<V> || std::is_nothrow_move_constructible_v<V>);
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+        template <typename C, typename... Args>
+        concept invocable = requires(C&& code, Args&&... args) {
+            std::forward<C>(code)(std::forward<Args>(args)...);
+        } || (std::is_member_pointer_v<std::decay_t<C>> && std::is_invocable_v<C, Args...>);
+#endif
+
+        template <typename T>
+        class niche_storage {
+            T value;
+
+        public:
+            constexpr niche_storage() noexcept: value(niche_traits<T>::empty()) {}
+            constexpr niche_storage(std::nullopt_t) noexcept: niche_storage() {}
+
+            template <typename... Args>
+            constexpr explicit niche_storage(std::in_place_t, Args&&... args)
+                noexcept(std::is_nothrow_constructible_v<T, Args...>)
+                : value(std::forward<Args>(args)...) {}
+
+            constexpr explicit operator bool() const noexcept {
+                return !niche_traits<T>::is_empty(value);
+            }
+
+            // Trivial payloads are assigned, which is a constant expression in
+            // C++17 and makes no difference anyone can observe. Others are
+            // built in place; if that throws, the slot holds the empty value.
+            template <typename... Args>
+            constexpr auto emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> T& {
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    value = T(std::forward<Args>(args)...);
+                } else {
+                    value.~T();
+#if defined(__cpp_exceptions)
+                    try {
+                        ::new (static_cast<void*>(std::addressof(value))) T(std::forward<Args>(args)...);
+                    } catch (...) {
+                        ::new (static_cast<void*>(std::addressof(value))) T(niche_traits<T>::empty());
+                        throw;
+                    }
+#else
+                    ::new (static_cast<void*>(std::addressof(value))) T(std::forward<Args>(args)...);
+#endif
+                }
+                return value;
+            }
+
+            constexpr auto operator*() & noexcept -> T& { return value; }
+            constexpr auto operator*() const& noexcept -> const T& { return value; }
+            constexpr auto operator*() && noexcept -> T&& { return std::move(value); }
+
+            constexpr auto reset() noexcept -> void {
+                value = niche_traits<T>::empty();
+            }
+
+            constexpr auto swap(niche_storage& other) noexcept(std::is_nothrow_swappable_v<T>) -> void {
+                using std::swap;
+                swap(value, other.value);
+            }
+        };
+
+        // std::optional gets constexpr emplace(), reset() and swap() only in
+        // C++20. For trivial payloads, assigning a whole optional has the same
+        // effect and is a constant expression in C++17 too.
+        template <typename T>
+        class optional_storage : public std::optional<T> {
+            using base = std::optional<T>;
+
+            constexpr static bool trivial = std::is_trivially_copy_constructible_v<T> &&
+                                            std::is_trivially_copy_assignable_v<T> &&
+                                            std::is_trivially_destructible_v<T>;
+
+        public:
+            using base::base;
+
+            template <typename... Args>
+            constexpr auto emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> T& {
+                if constexpr (trivial) {
+                    base::operator=(base{std::in_place, std::forward<Args>(args)...});
+                    return **this;
+                } else {
+                    return base::emplace(std::forward<Args>(args)...);
+                }
+            }
+
+            constexpr auto reset() noexcept -> void {
+                if constexpr (trivial) base::operator=(base{});
+                else base::reset();
+            }
+
+            constexpr auto swap(optional_storage& other)
+                noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>) -> void {
+                if constexpr (trivial) {
+                    auto held = static_cast<const base&>(*this);
+                    base::operator=(other);
+                    other.base::operator=(held);
+                } else {
+                    base::swap(other);
+                }
+            }
+        };
+
+        template <typename T>
+        using storage = std::conditional_t<has_niche_v<T>, niche_storage<T>, optional_storage<T>>;
+
+        template <typename T, typename... Args>
+        constexpr bool is_nothrow_emplaceable_v = std::is_nothrow_constructible_v<T, Args...>;
+    }
+
     template <typename T>
     class maybe {
-        std::optional<T> data;
+        detail::storage<T> data;
+
+        friend struct detail::access;
 
     public:
         constexpr maybe() noexcept = default;
         constexpr maybe(std::nullopt_t) noexcept {}
-        constexpr explicit maybe(T value): data(std::move(value)) {}
-        constexpr maybe(const maybe&) = default;
-        constexpr maybe(maybe&&) = default;
+        constexpr explicit maybe(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : data(std::in_place, std::move(value)) {}
+        constexpr maybe(const maybe&) noexcept(std::is_nothrow_copy_constructible_v<T>) = default;
+        constexpr maybe(maybe&&) noexcept(std::is_nothrow_move_constructible_v<T>) = default;
+        constexpr auto operator=(const maybe&)
+            noexcept(std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_copy_assignable_v<T>)
+            -> maybe& = default;
+        constexpr auto operator=(maybe&&)
+            noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>)
+            -> maybe& = default;
+
+        template <typename... Args,
+                  typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+        constexpr explicit maybe(std::in_place_t, Args&&... args)
+            noexcept(std::is_nothrow_constructible_v<T, Args...>)
+            : data(std::in_place, std::forward<Args>(args)...) {}
+
+        template <typename... Args>
+        constexpr auto emplace(Args&&... args) noexcept(detail::is_nothrow_emplaceable_v<T, Args...>) -> T& {
+            return data.emplace(std::forward<Args>(args)...);
+        }
 
-        constexpr auto or_else(const T& alt) const& -> T {
+        constexpr auto reset() noexcept -> void {
+            data.reset();
+        }
+
+        constexpr auto swap(maybe& other)
+            noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>) -> void {
+            data.swap(other.data);
+        }
+
+        friend constexpr auto swap(maybe& a, maybe& b) noexcept(noexcept(a.swap(b))) -> void {
+            a.swap(b);
+        }
+
+        constexpr auto or_else(const T& alt) const& noexcept(std::is_nothrow_copy_constructible_v<T>) -> T {
             if (data) return *data;
             else return alt;
         }
 
-        constexpr auto or_else(T&& alt) const& -> T {
+        constexpr auto or_else(T&& alt) const&
+            noexcept(std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_move_constructible_v<T>) -> T {
             if (data) return *data;
             else return std::move(alt);
         }
 
-        constexpr auto or_else(const T& alt) && -> T {
+        constexpr auto or_else(const T& alt) &&
+            noexcept(std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_move_constructible_v<T>) -> T {
             if (data) return std::move(*data);
             else return alt;
         }
 
-        constexpr auto or_else(T&& alt) && -> T {
+        constexpr auto or_else(T&& alt) && noexcept(std::is_nothrow_move_constructible_v<T>) -> T {
             if (data) return std::move(*data);
             else return std::move(alt);
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C(T)>,
-                  typename = std::enable_if_t<!std::is_void_v<R>>>
-        constexpr auto then_do(C&& code) const& -> maybe<R> {
-            if (data) return maybe<R>{std::invoke(std::forward<C>(code), *data)};
-            else return maybe<R>{std::nullopt};
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, const T&>)
+        constexpr auto then_do(C&& code) const&
+            noexcept(detail::is_nothrow_then_do_v<C, const T&>) -> decltype(auto) {
+            using R = detail::invoke_result_t<C, const T&>;
+            if constexpr (std::is_void_v<R>) {
+                if (data) detail::invoke(std::forward<C>(code), *data);
+                return *this;
+            } else {
+                if (data) return maybe<R>{detail::invoke(std::forward<C>(code), *data)};
+                else return maybe<R>{std::nullopt};
+            }
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, detail::then_do_argument_t<C, T>> &&
+                     (detail::is_void_on_lvalue_v<C, T> || !std::is_void_v<detail::invoke_result_t<C, T>>))
+        constexpr auto then_do(C&& code) && noexcept(detail::is_nothrow_then_do_v<C, T>) -> decltype(auto) {
+            using R = detail::invoke_result_t<C, detail::then_do_argument_t<C, T>>;
+            static_assert(detail::is_void_on_lvalue_v<C, T> || !std::is_void_v<R>,
+                          "then_do() keeps the value for a callable returning void, so it must accept a T&");
+            if constexpr (std::is_void_v<R>) {
+                if (data) detail::invoke(std::forward<C>(code), *data);
+                return maybe<T>{std::move(*this)};
+            } else {
+                using result = maybe<detail::then_result_t<R>>;
+                if (data) return result{detail::invoke(std::forward<C>(code), std::move(*data))};
+                else return result{std::nullopt};
+            }
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C>)
+        constexpr auto or_else_do(C&& code) const&
+            noexcept(detail::is_nothrow_invocable_v<C> &&
+                     (std::is_void_v<detail::invoke_result_t<C>> ||
+                      (std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_move_constructible_v<T>)))
+            -> decltype(auto) {
+            using R = detail::invoke_result_t<C>;
+            if constexpr (std::is_void_v<R>) {
+                if (!data) detail::invoke(std::forward<C>(code));
+                return *this;
+            } else {
+                static_assert(std::is_same_v<R, T>, "or_else_do() needs a T() or void() callable");
+                if (!data) return maybe<T>{detail::invoke(std::forward<C>(code))};
+                else return maybe<T>{*this};
+            }
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C(T)>,
-                  typename = std::enable_if_t<!std::is_void_v<R>>>
-        constexpr auto then_do(C&& code) && -> maybe<R> {
-            if (data) return maybe<R>{std::invoke(std::forward<C>(code), std::move(*data))};
-            else return maybe<R>{std::nullopt};
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C>)
+        constexpr auto or_else_do(C&& code) &&
+            noexcept(detail::is_nothrow_invocable_v<C> && std::is_nothrow_move_constructible_v<T>) -> maybe<T> {
+            using R = detail::invoke_result_t<C>;
+            if constexpr (std::is_void_v<R>) {
+                if (!data) detail::invoke(std::forward<C>(code));
+                return std::move(*this);
+            } else {
+                static_assert(std::is_same_v<R, T>, "or_else_do() needs a T() or void() callable");
+                if (!data) return maybe<T>{detail::invoke(std::forward<C>(code))};
+                else return std::move(*this);
+            }
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C(T)>,
-                  typename = std::enable_if_t<std::is_void_v<R>>>
-        constexpr auto then_do(C&& code) const& -> maybe<T> {
-            if (data) std::invoke(std::forward<C>(code), *data);
-            return *this;
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, const T&>)
+        constexpr auto then_maybe(C&& code) const&
+            noexcept(detail::is_nothrow_invocable_v<C, const T&>) -> detail::invoke_result_t<C, const T&> {
+            using R = detail::invoke_result_t<C, const T&>;
+            static_assert(detail::is_maybe_v<R>, "then_maybe() needs a callable returning a maybe");
+            if (data) return detail::invoke(std::forward<C>(code), *data);
+            else return R{std::nullopt};
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C(T)>,
-                  typename = std::enable_if_t<std::is_void_v<R>>>
-        constexpr auto then_do(C&& code) && -> maybe<T> {
-            if (data) std::invoke(std::forward<C>(code), *data);
-            return std::move(*this);
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, T>)
+        constexpr auto then_maybe(C&& code) &&
+            noexcept(detail::is_nothrow_invocable_v<C, T>) -> detail::invoke_result_t<C, T> {
+            using R = detail::invoke_result_t<C, T>;
+            static_assert(detail::is_maybe_v<R>, "then_maybe() needs a callable returning a maybe");
+            if (data) return detail::invoke(std::forward<C>(code), std::move(*data));
+            else return R{std::nullopt};
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C()>,
-                  typename = std::enable_if_t<!std::is_void_v<R>>,
-                  typename = std::enable_if_t<std::is_same_v<R, T>>>
-        constexpr auto or_else_do(C&& code) const& -> maybe<T> {
-            if (!data) return maybe<T>{std::invoke(std::forward<C>(code))};
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C>)
+        constexpr auto or_maybe(C&& code) const&
+            noexcept(detail::is_nothrow_invocable_v<C> && std::is_nothrow_copy_constructible_v<T>) -> maybe<T> {
+            if (!data) return detail::invoke(std::forward<C>(code));
             else return *this;
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C()>,
-                  typename = std::enable_if_t<!std::is_void_v<R>>,
-                  typename = std::enable_if_t<std::is_same_v<R, T>>>
-        constexpr auto or_else_do(C&& code) && -> maybe<T> {
-            if (!data) return maybe<T>{std::invoke(std::forward<C>(code))};
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C>)
+        constexpr auto or_maybe(C&& code) &&
+            noexcept(detail::is_nothrow_invocable_v<C> && std::is_nothrow_move_constructible_v<T>) -> maybe<T> {
+            if (!data) return detail::invoke(std::forward<C>(code));
             else return std::move(*this);
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C()>,
-                  typename = std::enable_if_t<std::is_void_v<R>>>
-        constexpr auto or_else_do(C&& code) const& -> maybe<T> {
-            if (!data) std::invoke(std::forward<C>(code));
-            return *this;
+        constexpr auto as_ref() & noexcept -> maybe<T&> {
+            if (data) return maybe<T&>{*data};
+            else return std::nullopt;
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C()>,
-                  typename = std::enable_if_t<std::is_void_v<R>>>
-        constexpr auto or_else_do(C&& code) && -> maybe<T> {
-            if (!data) std::invoke(std::forward<C>(code));
-            return std::move(*this);
+        constexpr auto as_ref() const& noexcept -> maybe<const T&> {
+            if (data) return maybe<const T&>{*data};
+            else return std::nullopt;
+        }
+
+        auto as_ref() const&& -> void = delete;
+
+        constexpr auto begin() noexcept -> T* { return data ? std::addressof(*data) : nullptr; }
+        constexpr auto begin() const noexcept -> const T* { return data ? std::addressof(*data) : nullptr; }
+        constexpr auto end() noexcept -> T* { return begin() + (data ? 1 : 0); }
+        constexpr auto end() const noexcept -> const T* { return begin() + (data ? 1 : 0); }
+    };
+
+    template <typename T>
+    class maybe<T&> {
+        T* data = nullptr;
+
+        template <typename> friend class maybe;
+        friend struct detail::access;
+
+    public:
+        constexpr maybe() noexcept = default;
+        constexpr maybe(std::nullopt_t) noexcept {}
+        constexpr explicit maybe(T& value) noexcept: data(std::addressof(value)) {}
+        explicit maybe(const T&&) = delete;
+        constexpr maybe(const maybe&) noexcept = default;
+
+        template <typename U,
+                  typename = std::enable_if_t<!std::is_same_v<U, T> &&
+                                              std::is_convertible_v<U*, T*>>>
+        constexpr maybe(const maybe<U&>& other) noexcept: data(other.data) {}
+
+        constexpr auto operator=(const maybe&) noexcept -> maybe& = default;
+
+        constexpr auto reset() noexcept -> void {
+            data = nullptr;
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C(T)>>
-        constexpr auto then_maybe(C&& code) const& -> R {
-            if (data) return ensure_type(std::invoke(std::forward<C>(code), *data));
-            else return ensure_type(R{std::nullopt});
+        constexpr auto swap(maybe& other) noexcept -> void {
+            auto held = data;
+            data = other.data;
+            other.data = held;
         }
 
-        template <typename C,
-                  typename R = std::result_of_t<C(T)>>
-        constexpr auto then_maybe(C&& code) && -> R {
-            if (data) return ensure_type(std::invoke(std::forward<C>(code), *data));
-            else return ensure_type(R{std::nullopt});
+        friend constexpr auto swap(maybe& a, maybe& b) noexcept -> void {
+            a.swap(b);
+        }
+
+        constexpr auto begin() const noexcept -> T* { return data; }
+        constexpr auto end() const noexcept -> T* { return data ? data + 1 : data; }
+
+        constexpr auto or_else(T& alt) const noexcept -> T& {
+            if (data) return *data;
+            else return alt;
+        }
+
+        constexpr auto or_else(std::remove_const_t<T>&& alt) const
+            noexcept(std::is_nothrow_copy_constructible_v<std::remove_const_t<T>> &&
+                     std::is_nothrow_move_constructible_v<std::remove_const_t<T>>) -> std::remove_const_t<T> {
+            if (data) return *data;
+            else return std::move(alt);
         }
 
         template <typename C>
-        constexpr auto or_maybe(C&& code) const& -> maybe<T> {
-            if (!data) return std::invoke(std::forward<C>(code));
-            else return *this;
+        HAN_REQUIRES(detail::invocable<C, T&>)
+        constexpr auto then_do(C&& code) const noexcept(detail::is_nothrow_then_do_v<C, T&>) {
+            using R = detail::invoke_result_t<C, T&>;
+            if constexpr (std::is_void_v<R>) {
+                if (data) detail::invoke(std::forward<C>(code), *data);
+                return *this;
+            } else {
+                if (data) return maybe<R>{detail::invoke(std::forward<C>(code), *data)};
+                else return maybe<R>{std::nullopt};
+            }
         }
 
         template <typename C>
-        constexpr auto or_maybe(C&& code) && -> maybe<T> {
-            if (!data) return std::invoke(std::forward<C>(code));
-            else return std::move(*this);
+        HAN_REQUIRES(detail::invocable<C>)
+        constexpr auto or_else_do(C&& code) const noexcept(detail::is_nothrow_invocable_v<C>) -> maybe {
+            using R = detail::invoke_result_t<C>;
+            if constexpr (std::is_void_v<R>) {
+                if (!data) detail::invoke(std::forward<C>(code));
+                return *this;
+            } else {
+                static_assert(std::is_same_v<R, T&>, "or_else_do() needs a T&() or void() callable");
+                if (!data) return maybe{detail::invoke(std::forward<C>(code))};
+                else return *this;
+            }
         }
 
-    private:
-        template <typename U>
-        constexpr static auto ensure_type(maybe<U> value) -> maybe<U> {
-            return value;
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, T&>)
+        constexpr auto then_maybe(C&& code) const
+            noexcept(detail::is_nothrow_invocable_v<C, T&>) -> detail::invoke_result_t<C, T&> {
+            using R = detail::invoke_result_t<C, T&>;
+            static_assert(detail::is_maybe_v<R>, "then_maybe() needs a callable returning a maybe");
+            if (data) return detail::invoke(std::forward<C>(code), *data);
+            else return R{std::nullopt};
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C>)
+        constexpr auto or_maybe(C&& code) const noexcept(detail::is_nothrow_invocable_v<C>) -> maybe {
+            if (!data) return detail::invoke(std::forward<C>(code));
+            else return *this;
         }
     };
 
     template <typename T> maybe(T) -> maybe<T>;
+
+    namespace detail {
+        struct access {
+            template <typename T>
+            constexpr static auto has_value(const maybe<T>& m) noexcept -> bool {
+                return static_cast<bool>(m.data);
+            }
+
+            template <typename M>
+            constexpr static auto value(M&& m) noexcept -> decltype(auto) {
+                return *std::forward<M>(m).data;
+            }
+        };
+
+        template <typename M>
+        struct payload {};
+
+        template <typename T>
+        struct payload<maybe<T>> {
+            using type = T;
+        };
+
+        template <typename M>
+        using payload_t = typename payload<std::remove_cv_t<std::remove_reference_t<M>>>::type;
+
+        template <typename M>
+        using forwarded_t = decltype(access::value(std::declval<M>()));
+    }
+
+    template <typename T, typename... Args>
+    constexpr auto make_maybe(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> maybe<T> {
+        return maybe<T>{std::in_place, std::forward<Args>(args)...};
+    }
+
+    namespace detail {
+        template <typename T>
+        using compared_t = const std::remove_reference_t<T>&;
+
+        template <typename U>
+        constexpr bool is_plain_operand_v = !is_maybe_v<U> && !std::is_same_v<U, std::nullopt_t>;
+
+        template <typename Op, typename T, typename U>
+        using comparison_t = decltype(static_cast<bool>(std::declval<Op>()(std::declval<compared_t<T>>(),
+                                                                           std::declval<compared_t<U>>())));
+
+        template <typename U, typename Op, typename T, typename V>
+        using plain_comparison_t = std::enable_if_t<is_plain_operand_v<U>, comparison_t<Op, T, V>>;
+
+        // Two absent maybes are equal and an absent maybe orders before any
+        // value, so whenever one side is missing `op` just compares presence.
+        template <typename Op, typename T, typename U>
+        constexpr auto compare(const maybe<T>& a, const maybe<U>& b, Op op)
+            noexcept(noexcept(op(access::value(a), access::value(b)))) -> bool {
+            auto pa = access::has_value(a);
+            auto pb = access::has_value(b);
+            return pa && pb ? static_cast<bool>(op(access::value(a), access::value(b))) : op(pa, pb);
+        }
+
+        template <typename Op, typename T, typename U>
+        constexpr auto compare(const maybe<T>& a, const U& b, Op op) noexcept(noexcept(op(access::value(a), b))) -> bool {
+            return access::has_value(a) ? static_cast<bool>(op(access::value(a), b)) : op(false, true);
+        }
+
+        template <typename Op, typename T, typename U>
+        constexpr auto compare(const U& a, const maybe<T>& b, Op op) noexcept(noexcept(op(a, access::value(b)))) -> bool {
+            return access::has_value(b) ? static_cast<bool>(op(a, access::value(b))) : op(true, false);
+        }
+
+        constexpr auto empty_hash = std::size_t{0x9e37'79b9'7f4a'7c15 & SIZE_MAX};
+
+        // A present maybe hashes like its payload, so lookups with a bare
+        // value (or anything hashing like it) find the same bucket.
+        template <typename T>
+        auto hash(const maybe<T>& m)
+            noexcept(noexcept(std::hash<std::remove_cv_t<std::remove_reference_t<T>>>{}(access::value(m)))) -> std::size_t {
+            using hasher = std::hash<std::remove_cv_t<std::remove_reference_t<T>>>;
+            return access::has_value(m) ? hasher{}(access::value(m)) : empty_hash;
+        }
+    }
+
+#define HAN_MAYBE_COMPARISON(op, function)                                                                      \
+    template <typename T, typename U>                                                                           \
+    constexpr auto operator op(const maybe<T>& a, const maybe<U>& b)                                            \
+        noexcept(noexcept(detail::compare(a, b, function{}))) -> detail::comparison_t<function, T, U> {          \
+        return detail::compare(a, b, function{});                                                               \
+    }                                                                                                           \
+    template <typename T, typename U>                                                                           \
+    constexpr auto operator op(const maybe<T>& a, const U& b)                                                   \
+        noexcept(noexcept(detail::compare(a, b, function{}))) -> detail::plain_comparison_t<U, function, T, U> { \
+        return detail::compare(a, b, function{});                                                               \
+    }                                                                                                           \
+    template <typename U, typename T>                                                                           \
+    constexpr auto operator op(const U& a, const maybe<T>& b)                                                   \
+        noexcept(noexcept(detail::compare(a, b, function{}))) -> detail::plain_comparison_t<U, function, U, T> { \
+        return detail::compare(a, b, function{});                                                               \
+    }                                                                                                           \
+    template <typename T>                                                                                       \
+    constexpr auto operator op(const maybe<T>& a, std::nullopt_t) noexcept -> bool {                            \
+        return detail::access::has_value(a) op false;                                                           \
+    }                                                                                                           \
+    template <typename T>                                                                                       \
+    constexpr auto operator op(std::nullopt_t, const maybe<T>& b) noexcept -> bool {                            \
+        return false op detail::access::has_value(b);                                                           \
+    }
+
+    HAN_MAYBE_COMPARISON(==, std::equal_to<>)
+    HAN_MAYBE_COMPARISON(!=, std::not_equal_to<>)
+    HAN_MAYBE_COMPARISON(<, std::less<>)
+    HAN_MAYBE_COMPARISON(<=, std::less_equal<>)
+    HAN_MAYBE_COMPARISON(>, std::greater<>)
+    HAN_MAYBE_COMPARISON(>=, std::greater_equal<>)
+#undef HAN_MAYBE_COMPARISON
+
+#if defined(__cpp_lib_three_way_comparison)
+    template <typename T, typename U>
+        requires std::three_way_comparable_with<detail::compared_t<T>, detail::compared_t<U>>
+    constexpr auto operator<=>(const maybe<T>& a, const maybe<U>& b)
+        noexcept(noexcept(detail::access::value(a) <=> detail::access::value(b)))
+        -> std::compare_three_way_result_t<detail::compared_t<T>, detail::compared_t<U>> {
+        auto pa = detail::access::has_value(a);
+        auto pb = detail::access::has_value(b);
+        if (pa && pb) return detail::access::value(a) <=> detail::access::value(b);
+        return pa <=> pb;
+    }
+
+    template <typename T, typename U>
+        requires detail::is_plain_operand_v<U> && std::three_way_comparable_with<detail::compared_t<T>, const U&>
+    constexpr auto operator<=>(const maybe<T>& a, const U& b) noexcept(noexcept(detail::access::value(a) <=> b))
+        -> std::compare_three_way_result_t<detail::compared_t<T>, const U&> {
+        if (detail::access::has_value(a)) return detail::access::value(a) <=> b;
+        return std::strong_ordering::less;
+    }
+
+    template <typename T>
+    constexpr auto operator<=>(const maybe<T>& a, std::nullopt_t) noexcept -> std::strong_ordering {
+        return detail::access::has_value(a) <=> false;
+    }
+#endif
+
+    struct maybe_hash {
+        using is_transparent = void;
+
+        template <typename K>
+        auto operator()(const K& key) const noexcept(noexcept(hash(key))) -> std::size_t {
+            return hash(key);
+        }
+
+    private:
+        // Bare C strings are hashed by their text, so a maybe holding one is
+        // too; std::hash<const char*> would hash the pointer.
+        template <typename T>
+        static auto hash(const maybe<T>& m) noexcept(noexcept(detail::hash(m))) -> std::size_t {
+            if constexpr (std::is_pointer_v<std::decay_t<T>> && std::is_convertible_v<const T&, std::string_view>)
+                return detail::access::has_value(m) ? hash(std::string_view{detail::access::value(m)}) : detail::empty_hash;
+            else
+                return detail::hash(m);
+        }
+
+        static auto hash(std::nullopt_t) noexcept -> std::size_t {
+            return detail::empty_hash;
+        }
+
+        static auto hash(std::string_view key) noexcept -> std::size_t {
+            return std::hash<std::string_view>{}(key);
+        }
+
+        template <typename K, typename = std::enable_if_t<detail::is_plain_operand_v<K> &&
+                                                          !std::is_convertible_v<const K&, std::string_view>>>
+        static auto hash(const K& key) noexcept(noexcept(std::hash<K>{}(key))) -> std::size_t {
+            return std::hash<K>{}(key);
+        }
+    };
+}
+
+namespace std {
+    template <typename T>
+    struct hash<han::maybe<T>> {
+        auto operator()(const han::maybe<T>& m) const noexcept(noexcept(han::detail::hash(m))) -> std::size_t {
+            return han::detail::hash(m);
+        }
+    };
 }
 
 #endif
@@ -0,0 +1,180 @@
+#ifndef HAN_MAYBE_VECTOR_HH
+#define HAN_MAYBE_VECTOR_HH
+#include <han/maybe.hh>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace han {
+    template <typename T>
+    class maybe_vector {
+        static_assert(std::is_default_constructible_v<T>,
+                      "absent elements of maybe_vector<T> hold a default-constructed T");
+
+        std::vector<T> values;
+        std::vector<std::uint64_t> validity;
+
+    public:
+        using value_type = maybe<T>;
+        using size_type = std::size_t;
+        using word_type = std::uint64_t;
+
+        constexpr static size_type word_bits = 64;
+
+        template <bool Const>
+        class basic_iterator {
+            using owner_type = std::conditional_t<Const, const maybe_vector, maybe_vector>;
+
+            owner_type* owner = nullptr;
+            size_type index = 0;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = maybe<std::conditional_t<Const, const T&, T&>>;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type;
+            using pointer = void;
+
+            constexpr basic_iterator() noexcept = default;
+            constexpr basic_iterator(owner_type* owner_, size_type index_) noexcept
+                : owner(owner_), index(index_) {}
+
+            constexpr auto operator*() const -> reference { return (*owner)[index]; }
+            constexpr auto operator++() noexcept -> basic_iterator& { ++index; return *this; }
+            constexpr auto operator++(int) noexcept -> basic_iterator { auto copy = *this; ++index; return copy; }
+
+            constexpr auto operator==(const basic_iterator& other) const noexcept -> bool {
+                return index == other.index;
+            }
+            constexpr auto operator!=(const basic_iterator& other) const noexcept -> bool {
+                return index != other.index;
+            }
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        maybe_vector() = default;
+
+        maybe_vector(std::initializer_list<maybe<T>> init) {
+            reserve(init.size());
+            for (const auto& value : init) push_back(value);
+        }
+
+        auto size() const noexcept -> size_type { return values.size(); }
+        auto empty() const noexcept -> bool { return values.empty(); }
+        auto capacity() const noexcept -> size_type { return values.capacity(); }
+
+        auto reserve(size_type count) -> void {
+            values.reserve(count);
+            validity.reserve(words_for(count));
+        }
+
+        auto clear() noexcept -> void {
+            values.clear();
+            validity.clear();
+        }
+
+        auto count() const noexcept -> size_type {
+            auto total = size_type{0};
+            for (auto word : validity) total += static_cast<size_type>(__builtin_popcountll(word));
+            return total;
+        }
+
+        auto push_back(std::nullopt_t) -> void {
+            reserve_word();
+            values.emplace_back();
+            grow_validity(false);
+        }
+
+        auto push_back(const T& value) -> void {
+            reserve_word();
+            values.push_back(value);
+            grow_validity(true);
+        }
+
+        auto push_back(T&& value) -> void {
+            reserve_word();
+            values.push_back(std::move(value));
+            grow_validity(true);
+        }
+
+        auto push_back(maybe<T> value) -> void {
+            value.as_ref()
+                .then_do([&](T& x) { push_back(std::move(x)); })
+                .or_else_do([&] { push_back(std::nullopt); });
+        }
+
+        template <typename... Args>
+        auto emplace_back(Args&&... args) -> T& {
+            reserve_word();
+            auto& value = values.emplace_back(std::forward<Args>(args)...);
+            grow_validity(true);
+            return value;
+        }
+
+        auto operator[](size_type index) noexcept -> maybe<T&> {
+            if (test(index)) return maybe<T&>{values[index]};
+            else return std::nullopt;
+        }
+
+        auto operator[](size_type index) const noexcept -> maybe<const T&> {
+            if (test(index)) return maybe<const T&>{values[index]};
+            else return std::nullopt;
+        }
+
+        auto get(size_type index) const -> maybe<T> {
+            if (test(index)) return maybe<T>{values[index]};
+            else return std::nullopt;
+        }
+
+        auto set(size_type index, T value) -> void {
+            values[index] = std::move(value);
+            validity[index / word_bits] |= bit(index);
+        }
+
+        auto reset(size_type index) -> void {
+            values[index] = T{};
+            validity[index / word_bits] &= ~bit(index);
+        }
+
+        auto begin() noexcept -> iterator { return {this, 0}; }
+        auto end() noexcept -> iterator { return {this, size()}; }
+        auto begin() const noexcept -> const_iterator { return {this, 0}; }
+        auto end() const noexcept -> const_iterator { return {this, size()}; }
+        auto cbegin() const noexcept -> const_iterator { return begin(); }
+        auto cend() const noexcept -> const_iterator { return end(); }
+
+        auto data() noexcept -> T* { return values.data(); }
+        auto data() const noexcept -> const T* { return values.data(); }
+        auto bitmap() noexcept -> word_type* { return validity.data(); }
+        auto bitmap() const noexcept -> const word_type* { return validity.data(); }
+
+        constexpr static auto words_for(size_type count) noexcept -> size_type {
+            return (count + word_bits - 1) / word_bits;
+        }
+
+    private:
+        constexpr static auto bit(size_type index) noexcept -> word_type {
+            return word_type{1} << (index % word_bits);
+        }
+
+        auto test(size_type index) const noexcept -> bool {
+            return (validity[index / word_bits] & bit(index)) != 0;
+        }
+
+        auto reserve_word() -> void {
+            if (values.size() % word_bits == 0 && validity.size() == validity.capacity())
+                validity.reserve(validity.empty() ? 1 : validity.size() * 2);
+        }
+
+        auto grow_validity(bool present) noexcept -> void {
+            auto index = values.size() - 1;
+            if (index % word_bits == 0) validity.push_back(0);
+            if (present) validity.back() |= bit(index);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef HAN_PARALLEL_HH
+#define HAN_PARALLEL_HH
+#include <han/maybe.hh>
+#include <han/thread_pool.hh>
+#include <algorithm>
+#include <iterator>
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+namespace han {
+    namespace detail {
+        template <typename O>
+        constexpr auto cache_line_elements() noexcept -> std::size_t {
+            using value_type = typename std::iterator_traits<O>::value_type;
+            if constexpr (std::is_void_v<value_type>) return 1;
+            else return std::max<std::size_t>(64 / sizeof(value_type), 1);
+        }
+
+        template <typename I, typename O, typename Step>
+        auto parallel_transform(thread_pool& pool, I first, I last, O out, Step step) -> O {
+            static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                            typename std::iterator_traits<I>::iterator_category>,
+                          "the input range must be random access");
+            auto count = static_cast<std::size_t>(std::distance(first, last));
+            auto grain = std::max<std::size_t>(1024 / cache_line_elements<O>(), 1) * cache_line_elements<O>();
+            pool.parallel_for(count, grain, [&](std::size_t begin, std::size_t end) {
+                auto in = first + static_cast<std::ptrdiff_t>(begin);
+                auto to = out + static_cast<std::ptrdiff_t>(begin);
+                for (auto i = begin; i != end; ++i, ++in, ++to) *to = step(*in);
+            });
+            return out + static_cast<std::ptrdiff_t>(count);
+        }
+
+#if defined(__cpp_lib_execution)
+        template <typename P>
+        constexpr bool is_execution_policy_v = std::is_execution_policy_v<std::decay_t<P>>;
+#else
+        template <typename P>
+        constexpr bool is_execution_policy_v = false;
+#endif
+    }
+
+    template <typename I, typename O, typename C>
+    auto transform_maybe(thread_pool& pool, I first, I last, O out, C code) -> O {
+        return detail::parallel_transform(pool, first, last, out, [&](const auto& value) {
+            return value.then_do(code);
+        });
+    }
+
+    template <typename I, typename O, typename C>
+    auto then_maybe_each(thread_pool& pool, I first, I last, O out, C code) -> O {
+        return detail::parallel_transform(pool, first, last, out, [&](const auto& value) {
+            return value.then_maybe(code);
+        });
+    }
+
+    template <typename P, typename I, typename O, typename C,
+              typename = std::enable_if_t<detail::is_execution_policy_v<P>>>
+    auto transform_maybe(P&& policy, I first, I last, O out, C code) -> O {
+        return std::transform(std::forward<P>(policy), first, last, out, [&](const auto& value) {
+            return value.then_do(code);
+        });
+    }
+
+    template <typename P, typename I, typename O, typename C,
+              typename = std::enable_if_t<detail::is_execution_policy_v<P>>>
+    auto then_maybe_each(P&& policy, I first, I last, O out, C code) -> O {
+        return std::transform(std::forward<P>(policy), first, last, out, [&](const auto& value) {
+            return value.then_maybe(code);
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef HAN_RELOCATE_HH
+#define HAN_RELOCATE_HH
+#include <han/maybe.hh>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace han {
+    template <typename T, typename = void>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    template <typename T>
+    struct is_trivially_relocatable<maybe<T>> : is_trivially_relocatable<T> {};
+
+    template <typename T>
+    struct is_trivially_relocatable<maybe<T&>> : std::true_type {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+    template <typename T>
+    constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+    template <typename T>
+    constexpr bool is_nothrow_relocatable_v =
+        is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    auto relocate(T* first, T* last, T* result) noexcept(is_nothrow_relocatable_v<T>) -> T* {
+        auto count = static_cast<std::size_t>(last - first);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (count != 0) std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), count * sizeof(T));
+            return result + count;
+        } else {
+            auto end = std::uninitialized_move(first, last, result);
+            std::destroy(first, last);
+            return end;
+        }
+    }
+
+    template <typename T>
+    auto relocate_at(T* source, T* target) noexcept(is_nothrow_relocatable_v<T>) -> T* {
+        return relocate(source, source + 1, target);
+    }
+}
+
+#endif
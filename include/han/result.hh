@@ -0,0 +1,323 @@
+#ifndef HAN_RESULT_HH
+#define HAN_RESULT_HH
+#include <han/maybe.hh>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace han {
+    template <typename E>
+    struct failure {
+        E error;
+    };
+
+    template <typename E>
+    failure(E) -> failure<E>;
+
+    template <typename E>
+    constexpr auto fail(E error) noexcept(std::is_nothrow_move_constructible_v<E>) -> failure<E> {
+        return failure<E>{std::move(error)};
+    }
+
+    template <typename T, typename E>
+    class result;
+
+    namespace detail {
+        template <typename T>
+        constexpr bool is_result_v = false;
+
+        template <typename T, typename E>
+        constexpr bool is_result_v<result<T, E>> = true;
+
+        // The value and the error share a union; the index is one byte.
+        template <typename T, typename E>
+        class variant_result {
+            std::variant<T, E> data;
+
+        public:
+            template <std::size_t I, typename... Args>
+            constexpr explicit variant_result(std::in_place_index_t<I> index, Args&&... args)
+                noexcept(std::is_nothrow_constructible_v<std::variant_alternative_t<I, std::variant<T, E>>, Args...>)
+                : data(index, std::forward<Args>(args)...) {}
+
+            constexpr auto ok() const noexcept -> bool { return data.index() == 0; }
+
+            constexpr auto value() & noexcept -> T& { return std::get<0>(data); }
+            constexpr auto value() const& noexcept -> const T& { return std::get<0>(data); }
+            constexpr auto value() && noexcept -> T&& { return std::move(std::get<0>(data)); }
+            constexpr auto error() const& noexcept -> const E& { return std::get<1>(data); }
+            constexpr auto error() && noexcept -> E&& { return std::move(std::get<1>(data)); }
+        };
+
+        // An empty error carries nothing but the fact that it happened, so
+        // the niche of T marks it and the result is as small as maybe<T>.
+        template <typename T, typename E>
+        class niche_result {
+            niche_storage<T> data;
+
+            constexpr static E none{};
+
+        public:
+            template <typename... Args>
+            constexpr explicit niche_result(std::in_place_index_t<0>, Args&&... args)
+                noexcept(std::is_nothrow_constructible_v<T, Args...>)
+                : data(std::in_place, std::forward<Args>(args)...) {}
+
+            template <typename... Args>
+            constexpr explicit niche_result(std::in_place_index_t<1>, Args&&...) noexcept {}
+
+            constexpr auto ok() const noexcept -> bool { return static_cast<bool>(data); }
+
+            constexpr auto value() & noexcept -> T& { return *data; }
+            constexpr auto value() const& noexcept -> const T& { return *data; }
+            constexpr auto value() && noexcept -> T&& { return *std::move(data); }
+            constexpr auto error() const& noexcept -> const E& { return none; }
+            constexpr auto error() && noexcept -> E { return none; }
+        };
+
+        template <typename T, typename E>
+        using result_storage =
+            std::conditional_t<has_niche_v<T> && std::is_empty_v<E> && std::is_trivial_v<E>,
+                               niche_result<T, E>, variant_result<T, E>>;
+
+        template <typename R>
+        using result_value_t = std::remove_cv_t<std::remove_reference_t<R>>;
+
+        template <typename S>
+        constexpr auto error_of(S&& storage) noexcept -> failure<decltype(std::forward<S>(storage).error())> {
+            return {std::forward<S>(storage).error()};
+        }
+
+        // Error handlers may take the error or ignore it.
+        template <typename C, typename Error, bool = std::is_invocable_v<C, Error>>
+        struct error_handler {
+            using type = invoke_result_t<C, Error>;
+            constexpr static bool nothrow = is_nothrow_invocable_v<C, Error>;
+        };
+
+        template <typename C, typename Error>
+        struct error_handler<C, Error, false> {
+            using type = invoke_result_t<C>;
+            constexpr static bool nothrow = is_nothrow_invocable_v<C>;
+        };
+
+        template <typename C, typename Error>
+        using error_handler_result_t = typename error_handler<C, Error>::type;
+
+        template <typename C, typename Error>
+        constexpr auto invoke_on_error(C&& code, Error&& error)
+            noexcept(error_handler<C, Error>::nothrow) -> decltype(auto) {
+            if constexpr (std::is_invocable_v<C, Error>) {
+                return invoke(std::forward<C>(code), std::forward<Error>(error));
+            } else {
+                static_cast<void>(error);
+                return invoke(std::forward<C>(code));
+            }
+        }
+
+        template <typename R, typename E, typename Error>
+        constexpr bool is_nothrow_result_v =
+            std::is_nothrow_constructible_v<result<result_value_t<R>, E>, R> && std::is_nothrow_constructible_v<E, Error>;
+
+        template <typename E, typename Error>
+        constexpr bool is_nothrow_result_v<void, E, Error> = true;
+    }
+
+    template <typename T, typename E>
+    class result {
+        static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>,
+                      "result<T, E> holds values; return maybe<T&> for references");
+
+        detail::result_storage<T, E> data;
+
+    public:
+        using value_type = T;
+        using error_type = E;
+
+        constexpr explicit result(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : data(std::in_place_index<0>, std::move(value)) {}
+
+        template <typename... Args,
+                  typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+        constexpr explicit result(std::in_place_t, Args&&... args)
+            noexcept(std::is_nothrow_constructible_v<T, Args...>)
+            : data(std::in_place_index<0>, std::forward<Args>(args)...) {}
+
+        template <typename G,
+                  typename = std::enable_if_t<std::is_constructible_v<E, G>>>
+        constexpr result(failure<G> error) noexcept(std::is_nothrow_constructible_v<E, G>)
+            : data(std::in_place_index<1>, std::forward<G>(error.error)) {}
+
+        constexpr auto or_else(const T& alt) const& noexcept(std::is_nothrow_copy_constructible_v<T>) -> T {
+            if (data.ok()) return data.value();
+            else return alt;
+        }
+
+        constexpr auto or_else(T&& alt) const&
+            noexcept(std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_move_constructible_v<T>) -> T {
+            if (data.ok()) return data.value();
+            else return std::move(alt);
+        }
+
+        constexpr auto or_else(const T& alt) &&
+            noexcept(std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_move_constructible_v<T>) -> T {
+            if (data.ok()) return std::move(data).value();
+            else return alt;
+        }
+
+        constexpr auto or_else(T&& alt) && noexcept(std::is_nothrow_move_constructible_v<T>) -> T {
+            if (data.ok()) return std::move(data).value();
+            else return std::move(alt);
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, const T&>)
+        constexpr auto then_do(C&& code) const&
+            noexcept(detail::is_nothrow_invocable_v<C, const T&> &&
+                     detail::is_nothrow_result_v<detail::invoke_result_t<C, const T&>, E, const E&>) -> decltype(auto) {
+            using R = detail::invoke_result_t<C, const T&>;
+            if constexpr (std::is_void_v<R>) {
+                if (data.ok()) detail::invoke(std::forward<C>(code), data.value());
+                return *this;
+            } else {
+                using next = result<detail::result_value_t<R>, E>;
+                if (data.ok()) return next{detail::invoke(std::forward<C>(code), data.value())};
+                else return next{detail::error_of(data)};
+            }
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, detail::then_do_argument_t<C, T>> &&
+                     (detail::is_void_on_lvalue_v<C, T> || !std::is_void_v<detail::invoke_result_t<C, T>>))
+        constexpr auto then_do(C&& code) &&
+            noexcept(detail::is_nothrow_invocable_v<C, detail::then_do_argument_t<C, T>> &&
+                     std::is_nothrow_move_constructible_v<result> &&
+                     detail::is_nothrow_result_v<detail::invoke_result_t<C, detail::then_do_argument_t<C, T>>, E, E>)
+            -> decltype(auto) {
+            using R = detail::invoke_result_t<C, detail::then_do_argument_t<C, T>>;
+            static_assert(detail::is_void_on_lvalue_v<C, T> || !std::is_void_v<R>,
+                          "then_do() keeps the value for a callable returning void, so it must accept a T&");
+            if constexpr (std::is_void_v<R>) {
+                if (data.ok()) detail::invoke(std::forward<C>(code), data.value());
+                return result{std::move(*this)};
+            } else {
+                using next = result<detail::result_value_t<R>, E>;
+                if (data.ok()) return next{detail::invoke(std::forward<C>(code), std::move(data).value())};
+                else return next{detail::error_of(std::move(data))};
+            }
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, const T&>)
+        constexpr auto then_maybe(C&& code) const&
+            noexcept(detail::is_nothrow_invocable_v<C, const T&> &&
+                     std::is_nothrow_constructible_v<E, const E&>) -> detail::invoke_result_t<C, const T&> {
+            using R = detail::invoke_result_t<C, const T&>;
+            static_assert(detail::is_result_v<R>, "then_maybe() on a result needs a callable returning a result");
+            if (data.ok()) return detail::invoke(std::forward<C>(code), data.value());
+            else return detail::error_of(data);
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, T>)
+        constexpr auto then_maybe(C&& code) &&
+            noexcept(detail::is_nothrow_invocable_v<C, T> && std::is_nothrow_move_constructible_v<E>)
+            -> detail::invoke_result_t<C, T> {
+            using R = detail::invoke_result_t<C, T>;
+            static_assert(detail::is_result_v<R>, "then_maybe() on a result needs a callable returning a result");
+            if (data.ok()) return detail::invoke(std::forward<C>(code), std::move(data).value());
+            else return detail::error_of(std::move(data));
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, const E&> || detail::invocable<C>)
+        constexpr auto or_else_do(C&& code) const&
+            noexcept(detail::error_handler<C, const E&>::nothrow && std::is_nothrow_copy_constructible_v<result> &&
+                     std::is_nothrow_move_constructible_v<T>) -> decltype(auto) {
+            using R = detail::error_handler_result_t<C, const E&>;
+            if constexpr (std::is_void_v<R>) {
+                if (!data.ok()) detail::invoke_on_error(std::forward<C>(code), data.error());
+                return *this;
+            } else {
+                static_assert(std::is_same_v<R, T>, "or_else_do() needs a T(E) or void(E) callable");
+                if (!data.ok()) return result{detail::invoke_on_error(std::forward<C>(code), data.error())};
+                else return result{*this};
+            }
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, E> || detail::invocable<C>)
+        constexpr auto or_else_do(C&& code) &&
+            noexcept(detail::error_handler<C, E>::nothrow && std::is_nothrow_move_constructible_v<result> &&
+                     std::is_nothrow_move_constructible_v<T>) -> result {
+            using R = detail::error_handler_result_t<C, E>;
+            if constexpr (std::is_void_v<R>) {
+                if (!data.ok()) detail::invoke_on_error(std::forward<C>(code), std::move(data).error());
+                return std::move(*this);
+            } else {
+                static_assert(std::is_same_v<R, T>, "or_else_do() needs a T(E) or void(E) callable");
+                if (!data.ok()) return result{detail::invoke_on_error(std::forward<C>(code), std::move(data).error())};
+                else return std::move(*this);
+            }
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, const E&> || detail::invocable<C>)
+        constexpr auto or_maybe(C&& code) const&
+            noexcept(detail::error_handler<C, const E&>::nothrow && std::is_nothrow_copy_constructible_v<T>)
+            -> detail::error_handler_result_t<C, const E&> {
+            using R = detail::error_handler_result_t<C, const E&>;
+            static_assert(detail::is_result_v<R> && std::is_same_v<typename R::value_type, T>,
+                          "or_maybe() on a result<T, E> needs a callable returning a result<T, F>");
+            if (!data.ok()) return detail::invoke_on_error(std::forward<C>(code), data.error());
+            else return R{data.value()};
+        }
+
+        template <typename C>
+        HAN_REQUIRES(detail::invocable<C, E> || detail::invocable<C>)
+        constexpr auto or_maybe(C&& code) &&
+            noexcept(detail::error_handler<C, E>::nothrow && std::is_nothrow_move_constructible_v<T>)
+            -> detail::error_handler_result_t<C, E> {
+            using R = detail::error_handler_result_t<C, E>;
+            static_assert(detail::is_result_v<R> && std::is_same_v<typename R::value_type, T>,
+                          "or_maybe() on a result<T, E> needs a callable returning a result<T, F>");
+            if (!data.ok()) return detail::invoke_on_error(std::forward<C>(code), std::move(data).error());
+            else return R{std::move(data).value()};
+        }
+
+        constexpr auto as_maybe() const& noexcept -> maybe<const T&> {
+            if (data.ok()) return maybe<const T&>{data.value()};
+            else return std::nullopt;
+        }
+
+        constexpr auto as_maybe() && noexcept(std::is_nothrow_move_constructible_v<T>) -> maybe<T> {
+            if (data.ok()) return maybe<T>{std::move(data).value()};
+            else return std::nullopt;
+        }
+
+        constexpr auto error() const& noexcept -> maybe<const E&> {
+            if (!data.ok()) return maybe<const E&>{data.error()};
+            else return std::nullopt;
+        }
+
+        constexpr auto error() && noexcept(std::is_nothrow_move_constructible_v<E>) -> maybe<E> {
+            if (!data.ok()) return maybe<E>{std::move(data).error()};
+            else return std::nullopt;
+        }
+    };
+
+    template <typename M, typename G,
+              typename = std::enable_if_t<detail::is_maybe_v<std::remove_cv_t<std::remove_reference_t<M>>>>>
+    constexpr auto to_result(M&& m, G error)
+        noexcept(std::is_nothrow_constructible_v<detail::result_value_t<detail::payload_t<M>>, detail::forwarded_t<M>> &&
+                 std::is_nothrow_move_constructible_v<detail::result_value_t<detail::payload_t<M>>> &&
+                 std::is_nothrow_move_constructible_v<G>)
+        -> result<detail::result_value_t<detail::payload_t<M>>, G> {
+        using R = result<detail::result_value_t<detail::payload_t<M>>, G>;
+        if (detail::access::has_value(m)) return R{detail::access::value(std::forward<M>(m))};
+        else return R{fail(std::move(error))};
+    }
+}
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef HAN_SERIALIZE_HH
+#define HAN_SERIALIZE_HH
+#include <han/maybe.hh>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "han/serialize.hh writes scalars in native byte order");
+
+namespace han {
+    template <typename T, typename = void>
+    struct serial_traits {};
+
+    namespace detail {
+        template <typename T, typename = void>
+        constexpr bool has_serial_fields_v = false;
+
+        template <typename T>
+        constexpr bool has_serial_fields_v<T, std::void_t<decltype(serial_traits<T>::tie(std::declval<T&>()))>> = true;
+
+        template <typename T>
+        constexpr bool is_vector_v = false;
+
+        template <typename T, typename A>
+        constexpr bool is_vector_v<std::vector<T, A>> = true;
+
+        template <typename T>
+        constexpr bool is_string_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+        template <typename T>
+        constexpr bool is_serializable_v = std::is_arithmetic_v<T> || std::is_enum_v<T> || is_string_v<T> ||
+                                           is_vector_v<T> || has_serial_fields_v<T>;
+
+        // One bit per maybe level: maybe<maybe<int>> takes two, int none.
+        template <typename T>
+        constexpr auto presence_bits() noexcept -> std::size_t {
+            if constexpr (is_maybe_v<T>) return 1 + presence_bits<payload_t<T>>();
+            else return 0;
+        }
+
+        template <typename Tuple>
+        struct field_bits;
+
+        template <typename... F>
+        struct field_bits<std::tuple<F...>> {
+            constexpr static auto value = (std::size_t{0} + ... + presence_bits<std::remove_cv_t<std::remove_reference_t<F>>>());
+        };
+
+        template <typename T>
+        constexpr auto frame_bits() noexcept -> std::size_t {
+            if constexpr (has_serial_fields_v<T>) return field_bits<decltype(serial_traits<T>::tie(std::declval<T&>()))>::value;
+            else return presence_bits<T>();
+        }
+
+        constexpr auto bytes_for(std::size_t bits) noexcept -> std::size_t {
+            return (bits + 7) / 8;
+        }
+
+        struct bit_cursor {
+            std::size_t offset = 0;
+            std::size_t index = 0;
+        };
+
+        class encoder {
+            std::vector<std::byte>& out;
+
+        public:
+            explicit encoder(std::vector<std::byte>& out_) noexcept: out(out_) {}
+
+            template <typename T>
+            auto frame(const T& value) -> void {
+                auto cursor = bitmap(frame_bits<T>());
+                if constexpr (has_serial_fields_v<T>)
+                    std::apply([&](const auto&... fields) { (chain(fields, cursor), ...); }, serial_traits<T>::tie(value));
+                else chain(value, cursor);
+            }
+
+        private:
+            auto bitmap(std::size_t bits) -> bit_cursor {
+                auto cursor = bit_cursor{out.size(), 0};
+                out.resize(out.size() + bytes_for(bits));
+                return cursor;
+            }
+
+            auto raw(const void* data, std::size_t size) -> void {
+                auto at = out.size();
+                out.resize(at + size);
+                if (size != 0) std::memcpy(out.data() + at, data, size);
+            }
+
+            auto varint(std::size_t n) -> void {
+                for (; n >= 0x80; n >>= 7) out.push_back(static_cast<std::byte>(n | 0x80));
+                out.push_back(static_cast<std::byte>(n));
+            }
+
+            template <typename T>
+            auto chain(const T& value, bit_cursor& cursor) -> void {
+                if constexpr (is_maybe_v<T>) {
+                    if (!access::has_value(value)) {
+                        cursor.index += presence_bits<T>();
+                        return;
+                    }
+                    out[cursor.offset + cursor.index / 8] |= static_cast<std::byte>(1u << (cursor.index % 8));
+                    ++cursor.index;
+                    chain(access::value(value), cursor);
+                } else {
+                    payload(value);
+                }
+            }
+
+            template <typename T>
+            auto payload(const T& value) -> void {
+                static_assert(is_serializable_v<T>, "serialize() needs arithmetic, enum, string, vector or a serial_traits type");
+                if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+                    raw(&value, sizeof value);
+                } else if constexpr (is_string_v<T>) {
+                    varint(value.size());
+                    raw(value.data(), value.size());
+                } else if constexpr (is_vector_v<T>) {
+                    using element = typename T::value_type;
+                    varint(value.size());
+                    auto cursor = bitmap(value.size() * presence_bits<element>());
+                    for (const auto& x : value) chain(x, cursor);
+                } else {
+                    frame(value);
+                }
+            }
+        };
+
+        class decoder {
+            const std::byte* next;
+            const std::byte* last;
+            bool failed = false;
+
+            struct bit_reader {
+                const std::byte* bits = nullptr;
+                std::size_t index = 0;
+            };
+
+        public:
+            decoder(const std::byte* first_, const std::byte* last_) noexcept: next(first_), last(last_) {}
+
+            auto ok() const noexcept -> bool { return !failed; }
+            auto position() const noexcept -> const std::byte* { return next; }
+
+            template <typename T>
+            auto frame(T& value) -> void {
+                auto bits = bit_reader{take(bytes_for(frame_bits<T>())), 0};
+                if constexpr (has_serial_fields_v<T>)
+                    std::apply([&](auto&... fields) { (chain(fields, bits), ...); }, serial_traits<T>::tie(value));
+                else chain(value, bits);
+            }
+
+        private:
+            auto take(std::size_t size) noexcept -> const std::byte* {
+                if (failed || static_cast<std::size_t>(last - next) < size) {
+                    failed = true;
+                    return nullptr;
+                }
+                auto at = next;
+                next += size;
+                return at;
+            }
+
+            auto varint() noexcept -> std::size_t {
+                auto n = std::size_t{0};
+                for (auto shift = 0u; shift < 64; shift += 7) {
+                    auto byte = take(1);
+                    if (byte == nullptr) return 0;
+                    n |= (std::to_integer<std::size_t>(*byte) & 0x7f) << shift;
+                    if ((std::to_integer<unsigned>(*byte) & 0x80) == 0) return n;
+                }
+                failed = true;
+                return 0;
+            }
+
+            static auto test(bit_reader& bits) noexcept -> bool {
+                if (bits.bits == nullptr) return false;
+                auto set = (std::to_integer<unsigned>(bits.bits[bits.index / 8]) >> (bits.index % 8)) & 1u;
+                ++bits.index;
+                return set != 0;
+            }
+
+            template <typename T>
+            auto chain(T& value, bit_reader& bits) -> void {
+                if constexpr (is_maybe_v<T>) {
+                    if (!test(bits)) {
+                        bits.index += presence_bits<T>() - 1;
+                        value.reset();
+                        return;
+                    }
+                    if (!access::has_value(value)) value.emplace();
+                    chain(access::value(value), bits);
+                } else {
+                    payload(value);
+                }
+            }
+
+            template <typename T>
+            auto payload(T& value) -> void {
+                static_assert(is_serializable_v<T>, "deserialize() needs arithmetic, enum, string, vector or a serial_traits type");
+                if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+                    if (auto bytes = take(sizeof value)) std::memcpy(&value, bytes, sizeof value);
+                } else if constexpr (is_string_v<T>) {
+                    auto size = varint();
+                    auto bytes = take(size);
+                    if (bytes == nullptr) return;
+                    if constexpr (std::is_same_v<T, std::string>) value.assign(reinterpret_cast<const char*>(bytes), size);
+                    else value = T(reinterpret_cast<const char*>(bytes), size);
+                } else if constexpr (is_vector_v<T>) {
+                    using element = typename T::value_type;
+                    auto size = varint();
+                    if (size > static_cast<std::size_t>(last - next) * 8) failed = true;
+                    if (failed) return;
+                    value.resize(size);
+                    auto bits = bit_reader{take(bytes_for(size * presence_bits<element>())), 0};
+                    for (auto& x : value) chain(x, bits);
+                } else {
+                    frame(value);
+                }
+            }
+        };
+    }
+
+    template <typename T>
+    auto serialize(const T& value, std::vector<std::byte>& out) -> void {
+        detail::encoder{out}.frame(value);
+    }
+
+    template <typename T>
+    auto serialize(const T& value) -> std::vector<std::byte> {
+        auto out = std::vector<std::byte>{};
+        serialize(value, out);
+        return out;
+    }
+
+    template <typename T>
+    auto deserialize(const std::byte* data, std::size_t size, T& value) -> maybe<std::size_t> {
+        auto in = detail::decoder{data, data + size};
+        in.frame(value);
+        if (in.ok()) return maybe<std::size_t>{static_cast<std::size_t>(in.position() - data)};
+        else return std::nullopt;
+    }
+}
+
+#endif
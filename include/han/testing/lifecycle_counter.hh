@@ -0,0 +1,182 @@
+#ifndef HAN_TESTING_LIFECYCLE_COUNTER_HH
+#define HAN_TESTING_LIFECYCLE_COUNTER_HH
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+namespace han::testing {
+    struct call_site {
+        const char* file;
+        unsigned line;
+
+        constexpr static auto current(const char* file = __builtin_FILE(),
+                                      unsigned line = __builtin_LINE()) noexcept -> call_site {
+            return {file, line};
+        }
+
+        friend auto operator<(const call_site& a, const call_site& b) noexcept -> bool {
+            auto order = std::strcmp(a.file, b.file);
+            return order < 0 || (order == 0 && a.line < b.line);
+        }
+
+        friend auto operator<<(std::ostream& out, const call_site& site) -> std::ostream& {
+            return out << site.file << ':' << site.line;
+        }
+    };
+
+    struct lifecycle_counts {
+        std::size_t constructions = 0;
+        std::size_t copies = 0;
+        std::size_t moves = 0;
+        std::size_t copy_assignments = 0;
+        std::size_t move_assignments = 0;
+        std::size_t destructions = 0;
+
+        auto operator+=(const lifecycle_counts& o) noexcept -> lifecycle_counts& {
+            constructions += o.constructions;
+            copies += o.copies;
+            moves += o.moves;
+            copy_assignments += o.copy_assignments;
+            move_assignments += o.move_assignments;
+            destructions += o.destructions;
+            return *this;
+        }
+
+        friend auto operator==(const lifecycle_counts& a, const lifecycle_counts& b) noexcept -> bool {
+            return std::tie(a.constructions, a.copies, a.moves, a.copy_assignments, a.move_assignments, a.destructions) ==
+                   std::tie(b.constructions, b.copies, b.moves, b.copy_assignments, b.move_assignments, b.destructions);
+        }
+
+        friend auto operator!=(const lifecycle_counts& a, const lifecycle_counts& b) noexcept -> bool {
+            return !(a == b);
+        }
+
+        friend auto operator<<(std::ostream& out, const lifecycle_counts& c) -> std::ostream& {
+            return out << "{constructions: " << c.constructions << ", copies: " << c.copies
+                       << ", moves: " << c.moves << ", copy assignments: " << c.copy_assignments
+                       << ", move assignments: " << c.move_assignments
+                       << ", destructions: " << c.destructions << '}';
+        }
+    };
+
+    class tracked;
+
+    class lifecycle_counter {
+        std::map<char, lifecycle_counts> tags;
+        std::map<call_site, lifecycle_counts> sites;
+        std::map<char, std::size_t> discarded;
+        std::string copy_log;
+        std::string move_log;
+
+        friend class tracked;
+
+    public:
+        auto make(char tag, call_site site = call_site::current()) -> tracked;
+
+        auto totals() const -> lifecycle_counts {
+            auto result = lifecycle_counts{};
+            for (const auto& entry : tags) result += entry.second;
+            return result;
+        }
+
+        auto totals(char tag) const -> lifecycle_counts {
+            if (auto it = tags.find(tag); it != tags.end()) return it->second;
+            else return {};
+        }
+
+        auto by_site() const -> const std::map<call_site, lifecycle_counts>& { return sites; }
+
+        // How many of the destructions counted for a tag were of objects
+        // whose value had been moved out.
+        auto destroyed_moved_from(char tag) const -> std::size_t {
+            if (auto it = discarded.find(tag); it != discarded.end()) return it->second;
+            else return 0;
+        }
+
+        auto copied() const -> const std::string& { return copy_log; }
+        auto moved() const -> const std::string& { return move_log; }
+
+        auto reset() -> void {
+            tags.clear();
+            sites.clear();
+            discarded.clear();
+            copy_log.clear();
+            move_log.clear();
+        }
+
+        auto report(std::ostream& out) const -> void {
+            for (const auto& [site, counts] : sites) out << site << ": " << counts << '\n';
+        }
+
+    private:
+        auto record(char tag, std::size_t lifecycle_counts::* field, call_site site) -> void {
+            ++(tags[tag].*field);
+            ++(sites[site].*field);
+        }
+    };
+
+    // Operators and destructors can't take a call_site, so assignments to
+    // an object and its destruction are counted at the site that
+    // constructed it.
+    class tracked {
+        lifecycle_counter* counter;
+        char x;
+        bool moved_out = false;
+        call_site origin;
+
+    public:
+        tracked(lifecycle_counter& counter_, char tag, call_site site = call_site::current())
+            : counter(&counter_), x(tag), origin(site) {
+            counter->record(x, &lifecycle_counts::constructions, site);
+        }
+
+        tracked(const tracked& o, call_site site = call_site::current())
+            : counter(o.counter), x(o.x), origin(site) {
+            counter->record(x, &lifecycle_counts::copies, site);
+            counter->copy_log += x;
+        }
+
+        tracked(tracked&& o, call_site site = call_site::current()) noexcept
+            : counter(o.counter), x(o.x), origin(site) {
+            o.moved_out = true;
+            counter->record(x, &lifecycle_counts::moves, site);
+            counter->move_log += x;
+        }
+
+        auto operator=(const tracked& o) -> tracked& {
+            counter = o.counter;
+            x = o.x;
+            moved_out = false;
+            counter->record(x, &lifecycle_counts::copy_assignments, origin);
+            counter->copy_log += x;
+            return *this;
+        }
+
+        auto operator=(tracked&& o) noexcept -> tracked& {
+            counter = o.counter;
+            x = o.x;
+            moved_out = false;
+            o.moved_out = true;
+            counter->record(x, &lifecycle_counts::move_assignments, origin);
+            counter->move_log += x;
+            return *this;
+        }
+
+        ~tracked() {
+            counter->record(x, &lifecycle_counts::destructions, origin);
+            if (moved_out) ++counter->discarded[x];
+        }
+
+        auto tag() const noexcept -> char { return x; }
+        auto moved_from() const noexcept -> bool { return moved_out; }
+    };
+
+    inline auto lifecycle_counter::make(char tag, call_site site) -> tracked {
+        return tracked{*this, tag, site};
+    }
+}
+
+#endif
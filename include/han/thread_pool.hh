@@ -0,0 +1,187 @@
+#ifndef HAN_THREAD_POOL_HH
+#define HAN_THREAD_POOL_HH
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace han {
+    class thread_pool;
+
+    namespace detail {
+        struct pool_worker {
+            const thread_pool* pool = nullptr;
+            std::size_t index = 0;
+        };
+    }
+
+    // Every worker has its own queue. Tasks submitted from a worker go to
+    // its queue, others are spread round-robin, and a worker whose queue is
+    // empty steals from the others. Queues are FIFO on both ends so that no
+    // task waits behind newer ones.
+    class thread_pool {
+        struct queue {
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        inline static thread_local detail::pool_worker current;
+
+        std::size_t worker_count;
+        std::unique_ptr<queue[]> queues;
+        std::vector<std::thread> workers;
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> pending{0};
+        std::atomic<std::size_t> sleepers{0};
+        std::mutex sleep_lock;
+        std::condition_variable ready;
+        bool stopping = false;
+
+    public:
+        // Workers read worker_count and queues while later ones are still
+        // being started, so both are set up first and never change.
+        explicit thread_pool(std::size_t threads = default_size())
+            : worker_count(std::max<std::size_t>(threads, 1)), queues(std::make_unique<queue[]>(worker_count)) {
+            workers.reserve(worker_count);
+            for (std::size_t i = 0; i < worker_count; ++i) workers.emplace_back([this, i] { work(i); });
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        auto operator=(const thread_pool&) -> thread_pool& = delete;
+
+        ~thread_pool() {
+            {
+                auto guard = std::lock_guard{sleep_lock};
+                stopping = true;
+            }
+            ready.notify_all();
+            for (auto& worker : workers) worker.join();
+        }
+
+        auto size() const noexcept -> std::size_t { return worker_count; }
+
+        static auto default_size() noexcept -> std::size_t {
+            return std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        static auto shared() -> thread_pool& {
+            static auto pool = thread_pool{};
+            return pool;
+        }
+
+        template <typename F>
+        auto submit(F&& task) -> void {
+            auto index = current.pool == this ? current.index : next.fetch_add(1, std::memory_order_relaxed) % size();
+            pending.fetch_add(1);
+            {
+                auto guard = std::lock_guard{queues[index].lock};
+                queues[index].tasks.emplace_back(std::forward<F>(task));
+            }
+            if (sleepers.load() != 0) {
+                // A worker between its check of pending and its wait holds
+                // sleep_lock, so the notification can't slip in between.
+                {
+                    auto guard = std::lock_guard{sleep_lock};
+                }
+                ready.notify_one();
+            }
+        }
+
+        template <typename F>
+        auto parallel_for(std::size_t count, std::size_t grain, F&& body) -> void {
+            grain = std::max<std::size_t>(grain, 1);
+            auto blocks = (count + grain - 1) / grain;
+            auto chunks = std::min(size(), blocks);
+            if (chunks <= 1) {
+                if (count != 0) body(std::size_t{0}, count);
+                return;
+            }
+            auto step = (blocks + chunks - 1) / chunks * grain;
+
+            struct {
+                std::mutex lock;
+                std::condition_variable done;
+                std::size_t remaining;
+                std::exception_ptr error;
+            } state;
+            state.remaining = chunks;
+
+            auto run = [&state, &body, count, step, chunks](std::size_t chunk) {
+                auto begin = std::min(chunk * step, count);
+                auto end = chunk + 1 == chunks ? count : std::min(begin + step, count);
+                auto error = std::exception_ptr{};
+#if defined(__cpp_exceptions)
+                try {
+                    if (begin != end) body(begin, end);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+#else
+                if (begin != end) body(begin, end);
+#endif
+                auto guard = std::lock_guard{state.lock};
+                if (error && !state.error) state.error = error;
+                if (--state.remaining == 0) state.done.notify_one();
+            };
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk) submit([&run, chunk] { run(chunk); });
+            run(0);
+
+            // The caller may be a worker, and the chunks may be queued behind
+            // it, so it runs queued tasks until every chunk has been taken.
+            // After that the workers running them finish them.
+            auto index = current.pool == this ? current.index : 0;
+            for (;;) {
+                {
+                    auto guard = std::lock_guard{state.lock};
+                    if (state.remaining == 0) break;
+                }
+                if (auto task = take(index)) {
+                    task();
+                    continue;
+                }
+                auto guard = std::unique_lock{state.lock};
+                state.done.wait(guard, [&] { return state.remaining == 0; });
+                break;
+            }
+            if (state.error) std::rethrow_exception(state.error);
+        }
+
+    private:
+        auto take(std::size_t index) -> std::function<void()> {
+            for (std::size_t i = 0; i < size(); ++i) {
+                auto& q = queues[(index + i) % size()];
+                auto guard = std::lock_guard{q.lock};
+                if (q.tasks.empty()) continue;
+                auto task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                pending.fetch_sub(1);
+                return task;
+            }
+            return {};
+        }
+
+        auto work(std::size_t index) -> void {
+            current = {this, index};
+            for (;;) {
+                if (auto task = take(index)) {
+                    task();
+                    continue;
+                }
+                auto guard = std::unique_lock{sleep_lock};
+                sleepers.fetch_add(1);
+                ready.wait(guard, [this] { return stopping || pending.load() != 0; });
+                sleepers.fetch_sub(1);
+                if (stopping && pending.load() == 0) return;
+            }
+        }
+    };
+}
+
+#endif
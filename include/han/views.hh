@@ -0,0 +1,300 @@
+#ifndef HAN_VIEWS_HH
+#define HAN_VIEWS_HH
+#include <han/maybe.hh>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+
+namespace han::views {
+    namespace detail {
+        using han::detail::access;
+        using han::detail::forwarded_t;
+        using han::detail::is_maybe_v;
+        using han::detail::payload_t;
+
+        template <typename T>
+        constexpr bool is_maybe_ref_v = false;
+
+        template <typename T>
+        constexpr bool is_maybe_ref_v<maybe<T&>> = true;
+
+#if defined(__cpp_lib_ranges)
+        using view_base = std::ranges::view_base;
+#else
+        struct view_base {};
+#endif
+
+        template <typename R>
+        using iterator_t = decltype(std::begin(std::declval<R&>()));
+
+        template <typename R>
+        using reference_t = decltype(*std::declval<const iterator_t<R>&>());
+
+        template <typename I>
+        constexpr bool is_forward_v = std::is_base_of_v<std::forward_iterator_tag,
+                                                        typename std::iterator_traits<I>::iterator_category>;
+
+        template <typename I, typename Reference>
+        struct iterator_tags {
+            using iterator_category = std::conditional_t<is_forward_v<I> && std::is_reference_v<Reference>,
+                                                         std::forward_iterator_tag, std::input_iterator_tag>;
+#if defined(__cpp_lib_ranges)
+            using iterator_concept = std::conditional_t<is_forward_v<I>,
+                                                        std::forward_iterator_tag, std::input_iterator_tag>;
+#endif
+        };
+
+        template <typename R>
+        class ref_view : public view_base {
+            R* range = nullptr;
+
+        public:
+            constexpr ref_view() noexcept = default;
+            constexpr explicit ref_view(R& range_) noexcept: range(std::addressof(range_)) {}
+
+            constexpr auto begin() const { return std::begin(*range); }
+            constexpr auto end() const { return std::end(*range); }
+        };
+
+        template <typename R>
+        using all_t = std::conditional_t<std::is_lvalue_reference_v<R>,
+                                         ref_view<std::remove_reference_t<R>>, std::decay_t<R>>;
+
+        template <typename R>
+        constexpr auto all(R&& range) -> all_t<R> {
+            if constexpr (std::is_lvalue_reference_v<R>) return ref_view<std::remove_reference_t<R>>{range};
+            else return std::move(range);
+        }
+
+        template <typename M>
+        using unwrapped_t = std::conditional_t<std::is_reference_v<M> || std::is_reference_v<payload_t<M>>,
+                                               forwarded_t<M>, payload_t<M>>;
+
+        template <typename F>
+        struct closure {
+            F apply;
+
+            template <typename R>
+            friend constexpr auto operator|(R&& range, const closure& c) {
+                return c.apply(std::forward<R>(range));
+            }
+        };
+
+        template <typename F>
+        closure(F) -> closure<F>;
+    }
+
+    template <typename V>
+    class present_view : public detail::view_base {
+        V base;
+
+        using base_iterator = detail::iterator_t<V>;
+        using base_reference = detail::reference_t<V>;
+
+        // An element the base computes on dereference is kept, so that
+        // testing it and reading it run the computation once.
+        static constexpr bool caches = !std::is_reference_v<base_reference>;
+        using cache_t = std::conditional_t<caches, std::remove_cv_t<base_reference>, std::nullopt_t>;
+
+    public:
+        class iterator : public detail::iterator_tags<base_iterator, detail::unwrapped_t<base_reference>> {
+            base_iterator current{};
+            base_iterator last{};
+            cache_t cache{std::nullopt};
+
+            constexpr auto skip() -> void {
+                for (; current != last; ++current) {
+                    if constexpr (caches) {
+                        cache = *current;
+                        if (detail::access::has_value(cache)) return;
+                    } else {
+                        if (detail::access::has_value(*current)) return;
+                    }
+                }
+            }
+
+        public:
+            using reference = detail::unwrapped_t<base_reference>;
+            using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+
+            constexpr iterator() = default;
+            constexpr iterator(base_iterator current_, base_iterator last_)
+                : current(std::move(current_)), last(std::move(last_)) { skip(); }
+
+            constexpr auto operator*() const -> reference {
+                if constexpr (caches) return detail::access::value(cache);
+                else return detail::access::value(*current);
+            }
+            constexpr auto operator++() -> iterator& { ++current; skip(); return *this; }
+            constexpr auto operator++(int) -> iterator { auto copy = *this; ++*this; return copy; }
+
+            constexpr auto operator==(const iterator& other) const -> bool { return current == other.current; }
+            constexpr auto operator!=(const iterator& other) const -> bool { return current != other.current; }
+        };
+
+        constexpr present_view() = default;
+        constexpr explicit present_view(V base_): base(std::move(base_)) {}
+
+        constexpr auto begin() -> iterator { return {std::begin(base), std::end(base)}; }
+        constexpr auto end() -> iterator { return {std::end(base), std::end(base)}; }
+    };
+
+    template <typename V, typename C>
+    class transform_maybe_view : public detail::view_base {
+        V base;
+        C code;
+
+        using base_iterator = detail::iterator_t<V>;
+        using base_reference = detail::reference_t<V>;
+        using result = decltype(std::declval<base_reference>().then_do(std::declval<C&>()));
+
+        static_assert(detail::is_maybe_v<result>, "transform_maybe() needs a callable returning a value");
+
+    public:
+        class iterator : public detail::iterator_tags<base_iterator, result> {
+            base_iterator current{};
+            C* code = nullptr;
+
+        public:
+            using reference = result;
+            using value_type = result;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+
+            constexpr iterator() = default;
+            constexpr iterator(base_iterator current_, C* code_): current(std::move(current_)), code(code_) {}
+
+            constexpr auto operator*() const -> reference { return (*current).then_do(*code); }
+            constexpr auto operator++() -> iterator& { ++current; return *this; }
+            constexpr auto operator++(int) -> iterator { auto copy = *this; ++current; return copy; }
+
+            constexpr auto operator==(const iterator& other) const -> bool { return current == other.current; }
+            constexpr auto operator!=(const iterator& other) const -> bool { return current != other.current; }
+        };
+
+        constexpr transform_maybe_view() = default;
+        constexpr transform_maybe_view(V base_, C code_): base(std::move(base_)), code(std::move(code_)) {}
+
+        constexpr auto begin() -> iterator { return {std::begin(base), std::addressof(code)}; }
+        constexpr auto end() -> iterator { return {std::end(base), std::addressof(code)}; }
+    };
+
+    template <typename V>
+    class flatten_view : public detail::view_base {
+        V base;
+
+        using outer_iterator = detail::iterator_t<V>;
+        using outer_reference = detail::reference_t<V>;
+        using inner_iterator = decltype(std::begin(std::declval<outer_reference>()));
+
+        static_assert(std::is_lvalue_reference_v<outer_reference> ||
+                      detail::is_maybe_ref_v<std::remove_cv_t<outer_reference>>,
+                      "flatten() needs inner ranges that outlive the iteration, use present() for computed maybes");
+
+    public:
+        class iterator : public detail::iterator_tags<outer_iterator, decltype(*std::declval<inner_iterator>())> {
+            outer_iterator outer{};
+            outer_iterator last{};
+            inner_iterator inner{};
+            inner_iterator inner_last{};
+
+            constexpr auto settle() -> void {
+                for (; outer != last; ++outer) {
+                    decltype(auto) range = *outer;
+                    inner = std::begin(range);
+                    inner_last = std::end(range);
+                    if (inner != inner_last) return;
+                }
+                inner = inner_last = inner_iterator{};
+            }
+
+        public:
+            using reference = decltype(*std::declval<inner_iterator>());
+            using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+
+            constexpr iterator() = default;
+            constexpr iterator(outer_iterator outer_, outer_iterator last_)
+                : outer(std::move(outer_)), last(std::move(last_)) { settle(); }
+
+            constexpr auto operator*() const -> reference { return *inner; }
+            constexpr auto operator++() -> iterator& {
+                if (++inner == inner_last) {
+                    ++outer;
+                    settle();
+                }
+                return *this;
+            }
+            constexpr auto operator++(int) -> iterator { auto copy = *this; ++*this; return copy; }
+
+            constexpr auto operator==(const iterator& other) const -> bool {
+                return outer == other.outer && inner == other.inner;
+            }
+            constexpr auto operator!=(const iterator& other) const -> bool { return !(*this == other); }
+        };
+
+        constexpr flatten_view() = default;
+        constexpr explicit flatten_view(V base_): base(std::move(base_)) {}
+
+        constexpr auto begin() -> iterator { return {std::begin(base), std::end(base)}; }
+        constexpr auto end() -> iterator { return {std::end(base), std::end(base)}; }
+    };
+
+    struct present_fn {
+        template <typename R>
+        constexpr auto operator()(R&& range) const {
+            return present_view<detail::all_t<R>>{detail::all(std::forward<R>(range))};
+        }
+
+        template <typename R>
+        friend constexpr auto operator|(R&& range, const present_fn& fn) {
+            return fn(std::forward<R>(range));
+        }
+    };
+
+    struct flatten_fn {
+        template <typename R>
+        constexpr auto operator()(R&& range) const {
+            return flatten_view<detail::all_t<R>>{detail::all(std::forward<R>(range))};
+        }
+
+        template <typename R>
+        friend constexpr auto operator|(R&& range, const flatten_fn& fn) {
+            return fn(std::forward<R>(range));
+        }
+    };
+
+    struct transform_maybe_fn {
+        template <typename R, typename C>
+        constexpr auto operator()(R&& range, C code) const {
+            return transform_maybe_view<detail::all_t<R>, C>{detail::all(std::forward<R>(range)), std::move(code)};
+        }
+
+        template <typename C>
+        constexpr auto operator()(C code) const {
+            return detail::closure{[code = std::move(code)](auto&& range) {
+                return transform_maybe_fn{}(std::forward<decltype(range)>(range), code);
+            }};
+        }
+    };
+
+    inline constexpr auto present = present_fn{};
+    inline constexpr auto flatten = flatten_fn{};
+    inline constexpr auto transform_maybe = transform_maybe_fn{};
+}
+
+#if defined(__cpp_lib_ranges)
+namespace std::ranges {
+    template <typename T>
+    inline constexpr bool enable_borrowed_range<han::maybe<T&>> = true;
+}
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef HAN_ZIP_HH
+#define HAN_ZIP_HH
+#include <han/maybe.hh>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace han {
+    namespace detail {
+        template <typename... M>
+        using zipped_t = std::tuple<payload_t<M>...>;
+
+        // What apply() returns for a callable returning R: then_do()'s
+        // result type, with a returned maybe taken as is, as then_maybe() does.
+        template <typename R, bool = is_maybe_v<std::remove_cv_t<std::remove_reference_t<R>>>>
+        struct applied {
+            using type = maybe<then_result_t<R>>;
+        };
+
+        template <typename R>
+        struct applied<R, true> {
+            using type = std::remove_cv_t<std::remove_reference_t<R>>;
+        };
+
+        template <typename R>
+        using applied_t = typename applied<R>::type;
+
+        template <typename R>
+        constexpr bool is_nothrow_wrappable_v =
+            std::conditional_t<std::is_void_v<R>, std::true_type, std::is_nothrow_constructible<applied_t<R>, R>>::value;
+
+        template <typename... M>
+        constexpr auto all_present(const M&... ms) noexcept -> bool {
+            return (static_cast<unsigned>(access::has_value(ms)) & ...) != 0;
+        }
+    }
+
+    template <typename... M>
+    constexpr auto zip(M&&... ms)
+        noexcept(std::is_nothrow_constructible_v<detail::zipped_t<M...>, detail::forwarded_t<M>...>)
+        -> maybe<detail::zipped_t<M...>> {
+        static_assert(sizeof...(M) > 0, "zip() needs at least one maybe");
+        using result = maybe<detail::zipped_t<M...>>;
+        if (detail::all_present(ms...)) return result{std::in_place, detail::access::value(std::forward<M>(ms))...};
+        else return std::nullopt;
+    }
+
+    template <typename C, typename... M>
+    constexpr auto apply(C&& code, M&&... ms)
+        noexcept(detail::is_nothrow_invocable_v<C, detail::forwarded_t<M>...> &&
+                 detail::is_nothrow_wrappable_v<detail::invoke_result_t<C, detail::forwarded_t<M>...>>) {
+        static_assert(sizeof...(M) > 0, "apply() needs at least one maybe");
+        using R = detail::invoke_result_t<C, detail::forwarded_t<M>...>;
+        auto present = detail::all_present(ms...);
+        if constexpr (std::is_void_v<R>) {
+            if (present) detail::invoke(std::forward<C>(code), detail::access::value(std::forward<M>(ms))...);
+            return present;
+        } else {
+            using result = detail::applied_t<R>;
+            if (present) return result{detail::invoke(std::forward<C>(code), detail::access::value(std::forward<M>(ms))...)};
+            else return result{std::nullopt};
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include <han/column_file.hh>
+#include <han/columns.hh>
+#include <han/views.hh>
+#include <boost/ut.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    struct temporary_file {
+        std::string path = "/tmp/han-column-" + std::to_string(::getpid()) + ".bin";
+
+        ~temporary_file() { std::remove(path.c_str()); }
+    };
+
+    template <typename T>
+    auto open(const std::string& path) -> han::mapped_column<T> {
+        return han::mapped_column<T>::open(path.c_str()).or_else(han::mapped_column<T>{});
+    }
+
+    template <typename C>
+    auto collect(const C& column) {
+        auto out = std::vector<han::maybe<std::remove_cv_t<std::remove_reference_t<decltype(*(*column.begin()).begin())>>>>{};
+        for (auto m : column) out.push_back(m.then_do([](auto x) { return x; }));
+        return out;
+    }
+
+    auto overwrite(const std::string& path, long at, const void* data, std::size_t size) -> void {
+        auto file = std::fopen(path.c_str(), "r+b");
+        std::fseek(file, at, SEEK_SET);
+        std::fwrite(data, 1, size, file);
+        std::fclose(file);
+    }
+}
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[fixed-width columns]"_test = [] {
+        "a maybe_vector round trips"_test = [] {
+            auto file = temporary_file{};
+            auto column = han::maybe_vector<double>{};
+            for (auto i = 0; i < 130; ++i) {
+                if (i % 3 == 0) column.push_back(std::nullopt);
+                else column.push_back(i * 0.5);
+            }
+            expect(han::write_column(file.path.c_str(), column));
+            auto mapped = open<double>(file.path);
+            expect(that % mapped.size() == 130u);
+            expect(that % mapped.count() == column.count());
+            auto expected = collect(column);
+            auto actual = collect(mapped);
+            expect(std::equal(actual.begin(), actual.end(), expected.begin(), expected.end()));
+            expect(mapped[0] == std::nullopt);
+            expect(mapped[1] == 0.5);
+            expect(mapped[129] == std::nullopt);
+        };
+        "a vector of maybes round trips"_test = [] {
+            auto file = temporary_file{};
+            auto column = std::vector<han::maybe<std::int32_t>>{han::maybe{7}, std::nullopt, han::maybe{-1}};
+            expect(han::write_column(file.path.c_str(), column));
+            auto mapped = open<std::int32_t>(file.path);
+            expect(collect(mapped) == column);
+            auto sum = 0;
+            for (auto x : mapped | han::views::present) sum += x;
+            expect(that % sum == 6);
+        };
+        "values are aligned in place"_test = [] {
+            auto file = temporary_file{};
+            auto column = std::vector<han::maybe<std::int64_t>>{han::maybe{std::int64_t{1}}, han::maybe{std::int64_t{2}}};
+            expect(han::write_column(file.path.c_str(), column));
+            auto mapped = open<std::int64_t>(file.path);
+            expect(that % (reinterpret_cast<std::uintptr_t>(mapped.data()) % 64) == 0u);
+            expect(that % (reinterpret_cast<std::uintptr_t>(mapped.bitmap()) % 64) == 0u);
+            expect(mapped[1].then_do([&](const std::int64_t& x) { return &x == mapped.data() + 1; }).or_else(false));
+        };
+        "absent slots are written as zero"_test = [] {
+            auto file = temporary_file{};
+            auto column = han::maybe_vector<std::int32_t>{};
+            for (auto i = 0; i < 130; ++i) column.push_back(i + 1);
+            han::columns::filter(column, [](std::int32_t x) { return x % 2 == 0; });
+            expect(that % column.data()[0] == 1);
+            expect(han::write_column(file.path.c_str(), column));
+            auto mapped = open<std::int32_t>(file.path);
+            expect(that % mapped.size() == 130u);
+            auto wrong = 0;
+            for (auto i = 0; i < 130; ++i) {
+                if (mapped.data()[i] != ((i + 1) % 2 == 0 ? i + 1 : 0)) ++wrong;
+            }
+            expect(that % wrong == 0);
+        };
+        "empty columns"_test = [] {
+            auto file = temporary_file{};
+            expect(han::write_column(file.path.c_str(), han::maybe_vector<float>{}));
+            auto mapped = han::mapped_column<float>::open(file.path.c_str());
+            expect(mapped.then_do([](const auto& c) { return c.empty(); }).or_else(false));
+        };
+    };
+
+    "[string columns]"_test = [] {
+        auto file = temporary_file{};
+        auto column = std::vector<han::maybe<std::string>>{han::maybe{"alpha"s}, std::nullopt, han::maybe{""s}, han::maybe{"omega"s}};
+        expect(han::write_column(file.path.c_str(), column));
+        auto mapped = open<std::string_view>(file.path);
+        expect(that % mapped.size() == 4u);
+        expect(mapped[0] == "alpha"sv);
+        expect(mapped[1] == std::nullopt);
+        expect(mapped[2] == ""sv);
+        expect(mapped[3] == "omega"sv);
+    };
+
+    "[rejected files]"_test = [] {
+        auto file = temporary_file{};
+        expect(han::mapped_column<int>::open("/nonexistent/han-column.bin") == std::nullopt);
+        auto column = std::vector<han::maybe<std::int32_t>>{han::maybe{1}, han::maybe{2}};
+        expect(han::write_column(file.path.c_str(), column));
+        expect(han::mapped_column<std::int32_t>::open(file.path.c_str()) != std::nullopt);
+        expect(han::mapped_column<std::int64_t>::open(file.path.c_str()) == std::nullopt);
+        expect(han::mapped_column<std::string_view>::open(file.path.c_str()) == std::nullopt);
+        auto rows = std::uint64_t{1000};
+        overwrite(file.path, offsetof(han::column_header, rows), &rows, sizeof rows);
+        expect(han::mapped_column<std::int32_t>::open(file.path.c_str()) == std::nullopt);
+        overwrite(file.path, 0, "garbage!", 8);
+        expect(han::mapped_column<std::int32_t>::open(file.path.c_str()) == std::nullopt);
+    };
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <han/columns.hh>
+#include <boost/ut.hpp>
+#include <random>
+#include <vector>
+
+template <typename T>
+auto column(std::size_t size, double ratio) -> han::maybe_vector<T> {
+    auto random = std::mt19937{7};
+    auto coin = std::bernoulli_distribution{ratio};
+    auto result = han::maybe_vector<T>{};
+    for (auto i = std::size_t{0}; i < size; ++i) {
+        if (coin(random)) result.push_back(static_cast<T>(i % 1000));
+        else result.push_back(std::nullopt);
+    }
+    return result;
+}
+
+template <typename T, typename C>
+auto reference_transform(const han::maybe_vector<T>& input, C code) -> std::vector<han::maybe<T>> {
+    auto result = std::vector<han::maybe<T>>{};
+    for (auto x : input) result.push_back(x.then_do(code));
+    return result;
+}
+
+template <typename T, typename P>
+auto reference_filter(const han::maybe_vector<T>& input, P predicate) -> std::vector<han::maybe<T>> {
+    auto result = std::vector<han::maybe<T>>{};
+    for (auto x : input) {
+        result.push_back(x.then_maybe([&](const T& y) {
+            if (predicate(y)) return han::maybe<T>{y};
+            else return han::maybe<T>{};
+        }));
+    }
+    return result;
+}
+
+template <typename T>
+auto same(const han::maybe_vector<T>& actual, const std::vector<han::maybe<T>>& expected) -> bool {
+    if (actual.size() != expected.size()) return false;
+    auto present = [](const T&) { return true; };
+    for (auto i = std::size_t{0}; i < actual.size(); ++i) {
+        if (actual[i].then_do(present).or_else(false) != expected[i].then_do(present).or_else(false)) return false;
+        auto a = actual[i].or_else(T{});
+        auto e = expected[i].or_else(T{});
+        if (a < e || e < a) return false;
+    }
+    return true;
+}
+
+auto main() -> int {
+    using namespace boost::ut;
+    using han::columns::isa;
+
+    for (auto level : {isa::scalar, isa::sse2, isa::avx2, isa::avx512}) {
+        if (!han::columns::supported(level)) continue;
+        for (auto ratio : {0.0, 0.3, 0.5, 0.97, 1.0}) {
+            for (auto size : {std::size_t{0}, std::size_t{1}, std::size_t{63}, std::size_t{64}, std::size_t{1000}}) {
+                test("[columns::transform()]") = [=] {
+                    auto input = column<float>(size, ratio);
+                    auto times = [](float x) { return x * 2.5f + 1.0f; };
+                    auto expected = reference_transform(input, times);
+                    han::columns::transform(input, times, level);
+                    expect(same(input, expected));
+                };
+                test("[columns::filter()]") = [=] {
+                    auto input = column<int>(size, ratio);
+                    auto odd = [](int x) { return x % 2 != 0; };
+                    auto expected = reference_filter(input, odd);
+                    han::columns::filter(input, odd, level);
+                    expect(same(input, expected));
+                };
+                test("[columns::filter() on doubles]") = [=] {
+                    auto input = column<double>(size, ratio);
+                    auto small = [](double x) { return x < 500.0; };
+                    auto expected = reference_filter(input, small);
+                    han::columns::filter(input, small, level);
+                    expect(same(input, expected));
+                };
+            }
+        }
+    }
+
+    for (auto level : {isa::scalar, isa::sse2, isa::avx2, isa::avx512}) {
+        if (!han::columns::supported(level)) continue;
+        test("[columns::transform() and filter() never see absent slots]") = [=] {
+            auto input = column<int>(1000, 0.97);
+            for (auto i = std::size_t{0}; i < 64; ++i) input.push_back(7);
+            auto seen_absent = false;
+            auto checked = [&](int x) {
+                seen_absent = seen_absent || x == 0;
+                return x;
+            };
+            han::columns::filter(input, [](int x) { return x != 0; }, level);
+            han::columns::transform(input, checked, level);
+            expect(!seen_absent);
+            auto expected = reference_transform(input, [](int x) { return 1000 / x; });
+            han::columns::transform(input, [](int x) { return 1000 / x; }, level);
+            expect(same(input, expected));
+        };
+    }
+
+    "[columns::transform() leaves absent slots alone]"_test = [] {
+        auto input = han::maybe_vector<int>{han::maybe{1}, std::nullopt, han::maybe{3}};
+        han::columns::transform(input, [](int x) { return x + 1; });
+        expect(that % input.data()[1] == 0);
+        expect(that % input[0].or_else(0) == 2);
+        expect(that % input[2].or_else(0) == 4);
+    };
+
+    return 0;
+}
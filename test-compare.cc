@@ -0,0 +1,147 @@
+#include <han/maybe.hh>
+#include <boost/ut.hpp>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+static_assert(han::maybe{1} == han::maybe{1});
+static_assert(han::maybe<int>{} == std::nullopt);
+static_assert(han::maybe<int>{} < han::maybe{0});
+static_assert(han::maybe{1} < 2 && 0 < han::maybe{1});
+static_assert(noexcept(han::maybe{1} < han::maybe{2}));
+#if defined(__cpp_lib_three_way_comparison)
+static_assert((han::maybe{1} <=> han::maybe{2}) < 0);
+static_assert((han::maybe<int>{} <=> 0) < 0);
+static_assert((han::maybe{0} <=> std::nullopt) > 0);
+static_assert(std::is_same_v<decltype(han::maybe{1.0} <=> han::maybe{2.0}), std::partial_ordering>);
+#endif
+static_assert(noexcept(std::hash<han::maybe<int>>{}(han::maybe{1})));
+
+template <typename A, typename B, typename = void>
+constexpr bool is_equality_comparable_v = false;
+
+template <typename A, typename B>
+constexpr bool is_equality_comparable_v<A, B, std::void_t<decltype(std::declval<A>() == std::declval<B>())>> = true;
+
+struct opaque {};
+static_assert(!is_equality_comparable_v<han::maybe<opaque>, han::maybe<opaque>>);
+static_assert(!is_equality_comparable_v<han::maybe<int>, std::string>);
+static_assert(is_equality_comparable_v<han::maybe<std::string>, std::string_view>);
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[comparison]"_test = [] {
+        "two maybes"_test = [] {
+            auto empty = han::maybe<int>{};
+            expect(han::maybe{1} == han::maybe{1});
+            expect(han::maybe{1} != han::maybe{2});
+            expect(empty == han::maybe<int>{});
+            expect(empty != han::maybe{0});
+            expect(empty < han::maybe{-1});
+            expect(han::maybe{1} < han::maybe{2});
+            expect(han::maybe{2} >= han::maybe{2});
+            expect(!(empty > empty));
+            expect(han::maybe{1} == han::maybe{1.0});
+        };
+        "against values and nullopt"_test = [] {
+            auto name = han::maybe{"b"s};
+            expect(name == "b"sv);
+            expect("a"sv < name);
+            expect(name <= "b"s);
+            expect(han::maybe<std::string>{} < "a"sv);
+            expect(han::maybe<std::string>{} != "a"sv);
+            expect(han::maybe<int>{} == std::nullopt);
+            expect(std::nullopt < han::maybe{0});
+            expect(han::maybe{0} > std::nullopt);
+            expect(!(std::nullopt < han::maybe<int>{}));
+        };
+        "references and niches"_test = [] {
+            auto x = 1;
+            auto y = 1;
+            expect(han::maybe<int&>{x} == han::maybe<int&>{y});
+            expect(han::maybe<int&>{x} == han::maybe{1});
+            expect(han::maybe<const int&>{} < han::maybe<int&>{x});
+            expect(han::maybe{0.5} < han::maybe{1.5});
+            expect(han::maybe<double>{} != han::maybe{0.0});
+            expect(han::maybe<std::string_view>{} < han::maybe{""sv});
+        };
+        "floating point stays partially ordered"_test = [] {
+            auto nan = han::maybe{std::numeric_limits<double>::quiet_NaN()};
+            expect(!(nan <= han::maybe{1.0}));
+            expect(!(nan >= han::maybe{1.0}));
+            expect(nan != nan);
+            expect(han::maybe<double>{} < nan);
+        };
+        "sorting puts absent first"_test = [] {
+            auto v = std::vector<han::maybe<int>>{han::maybe{3}, std::nullopt, han::maybe{1}, std::nullopt};
+            std::sort(v.begin(), v.end());
+            expect(v == std::vector<han::maybe<int>>{std::nullopt, std::nullopt, han::maybe{1}, han::maybe{3}});
+        };
+    };
+
+    "[hash]"_test = [] {
+        "present maybes hash like their payload"_test = [] {
+            expect(that % std::hash<han::maybe<int>>{}(han::maybe{7}) == std::hash<int>{}(7));
+            expect(that % std::hash<han::maybe<std::string>>{}(han::maybe{"key"s}) == std::hash<std::string_view>{}("key"sv));
+            auto x = 7;
+            expect(that % std::hash<han::maybe<int&>>{}(han::maybe<int&>{x}) == std::hash<int>{}(7));
+        };
+        "absent is not confused with the zero value"_test = [] {
+            expect(that % std::hash<han::maybe<int>>{}(han::maybe<int>{}) != std::hash<han::maybe<int>>{}(han::maybe{0}));
+            expect(that % std::hash<han::maybe<int>>{}({}) == han::maybe_hash{}(std::nullopt));
+        };
+        "unordered containers"_test = [] {
+            auto seen = std::unordered_set<han::maybe<int>>{han::maybe{1}, std::nullopt, han::maybe{1}, han::maybe{0}};
+            expect(that % seen.size() == 3u);
+            expect(that % seen.count(std::nullopt) == 1u);
+        };
+    };
+
+    "[heterogeneous lookup]"_test = [] {
+        "sorted containers with std::less<>"_test = [] {
+            auto index = std::map<han::maybe<std::string>, int, std::less<>>{{han::maybe{"a"s}, 1}, {std::nullopt, 0}};
+            expect(that % index.find("a"sv)->second == 1);
+            expect(that % index.find(std::nullopt)->second == 0);
+            expect(index.find("b"sv) == index.end());
+            auto keys = std::set<han::maybe<std::string>, std::less<>>{han::maybe{"x"s}};
+            expect(that % keys.count("x") == 1u);
+        };
+        "maybe_hash agrees with std::hash"_test = [] {
+            auto hash = han::maybe_hash{};
+            expect(that % hash(han::maybe{"a"s}) == hash("a"sv));
+            expect(that % hash(han::maybe{"a"s}) == hash("a"));
+            expect(that % hash(han::maybe{"a"s}) == std::hash<han::maybe<std::string>>{}(han::maybe{"a"s}));
+            expect(that % hash(han::maybe{5}) == hash(5));
+        };
+        "maybe_hash hashes a maybe C string like the C string"_test = [] {
+            auto hash = han::maybe_hash{};
+            const char* p = "key";
+            expect(that % hash(han::maybe{p}) == hash(p));
+            expect(that % hash(han::maybe<const char*>{}) == hash(std::nullopt));
+        };
+#if defined(__cpp_lib_generic_unordered_lookup)
+        "unordered containers of C strings"_test = [] {
+            const char* p = "key";
+            auto keys = std::unordered_set<han::maybe<const char*>, han::maybe_hash, std::equal_to<>>{han::maybe{p}};
+            expect(that % keys.count(p) == 1u);
+            expect(that % keys.count(han::maybe{p}) == 1u);
+        };
+        "unordered containers"_test = [] {
+            auto index = std::unordered_map<han::maybe<std::string>, int, han::maybe_hash, std::equal_to<>>{
+                {han::maybe{"a"s}, 1}, {std::nullopt, 0}};
+            expect(that % index.find("a"sv)->second == 1);
+            expect(that % index.find(std::nullopt)->second == 0);
+            expect(index.find("b"sv) == index.end());
+        };
+#endif
+    };
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <han/lazy.hh>
+#include <han/views.hh>
+#include <han/zip.hh>
+#include <boost/ut.hpp>
+#include <array>
+#include <functional>
+#include <string_view>
+
+namespace {
+    struct point {
+        int x = 0;
+        int y = 0;
+
+        constexpr auto sum() const noexcept -> int { return x + y; }
+    };
+
+    constexpr auto digit(char c) noexcept -> han::maybe<int> {
+        if (c >= '0' && c <= '9') return han::maybe{c - '0'};
+        else return std::nullopt;
+    }
+
+    constexpr auto parse(std::string_view text) noexcept -> han::maybe<int> {
+        auto total = han::maybe{0};
+        for (auto c : text)
+            total = han::apply([](int t, int d) { return t * 10 + d; }, total, digit(c)).or_maybe([] {
+                return han::maybe<int>{};
+            });
+        return text.empty() ? han::maybe<int>{} : total;
+    }
+
+    constexpr auto origin = point{};
+    constexpr auto square = [](int x) { return x * x; };
+    constexpr auto half = [](int x) { return x % 2 == 0 ? han::maybe{x / 2} : han::maybe<int>{}; };
+}
+
+// Construction, access and the combinators.
+static_assert(han::maybe{3}.then_do(square).or_else(0) == 9);
+static_assert(han::maybe<int>{}.then_do(square).or_else(-1) == -1);
+static_assert(han::maybe{4}.then_maybe(half).then_maybe(half).or_else(0) == 1);
+static_assert(han::maybe{6}.then_maybe(half).then_maybe(half).or_else(0) == 0);
+static_assert(han::maybe<int>{}.or_maybe([] { return han::maybe{7}; }).or_else(0) == 7);
+static_assert(han::maybe<int>{}.or_else_do([] { return 8; }) == 8);
+static_assert(han::maybe{point{1, 2}}.then_do(&point::sum).or_else(0) == 3);
+static_assert(han::maybe{point{4, 5}}.then_do(&point::y).or_else(0) == 5);
+static_assert(std::is_same_v<decltype(han::maybe{point{}}.then_do(&point::y)), han::maybe<int>>);
+static_assert(han::maybe{&origin}.then_do(&point::sum).or_else(-1) == 0);
+#if defined(__cpp_lib_constexpr_functional)
+static_assert(han::maybe{std::cref(origin)}.then_do(&point::x).or_else(-1) == 0);
+#endif
+static_assert(han::maybe{1.5}.then_do([](double x) { return x > 1; }).or_else(false));
+static_assert(han::maybe<std::string_view>{}.or_else("none") == "none");
+
+// Mutation through the whole API.
+static_assert([] {
+    auto m = han::maybe<int>{};
+    m.emplace(2);
+    auto n = han::maybe{5};
+    n.swap(m);
+    swap(m, n);
+    m.reset();
+    n = han::maybe{n.or_else(0) + 1};
+    return m == std::nullopt && n == 6;
+}());
+static_assert([] {
+    auto m = han::maybe{2.5};
+    m.reset();
+    m.emplace(0.5);
+    return m.or_else(0.0) < 1.0;
+}());
+static_assert([] {
+    auto x = 1;
+    auto r = han::maybe<int&>{x};
+    r.then_do([](int& v) { v += 41; });
+    auto s = han::maybe<int&>{};
+    r.swap(s);
+    return x == 42 && r == std::nullopt && s == 42;
+}());
+
+// Parsers built from maybe-returning functions.
+static_assert(parse("1234") == 1234);
+static_assert(parse("12a4") == std::nullopt);
+static_assert(parse("") == std::nullopt);
+
+// The other headers.
+static_assert(han::zip(han::maybe{1}, han::maybe{'a'}) != std::nullopt);
+static_assert(han::lazy(han::maybe{3}).then_do(square).then_maybe(half).or_else(0) == 0);
+static_assert(han::lazy(han::maybe{4}).then_maybe(half).then_do(square).or_else(0) == 4);
+static_assert([] {
+    constexpr auto values = std::array{han::maybe{1}, han::maybe<int>{}, han::maybe{3}};
+    auto sum = 0;
+    for (auto x : values | han::views::present) sum += x;
+    for (auto x : values | han::views::transform_maybe(square) | han::views::present) sum += x;
+    return sum == 14;
+}());
+
+// Tables generated at compile time with the runtime functions.
+constexpr auto digits = [] {
+    auto table = std::array<han::maybe<int>, 256>{};
+    for (auto c = 0; c < 256; ++c) table[static_cast<std::size_t>(c)] = digit(static_cast<char>(c));
+    return table;
+}();
+static_assert(digits['7'] == 7);
+static_assert(digits['x'] == std::nullopt);
+
+auto main() -> int {
+    using namespace boost::ut;
+
+    "[constant evaluation]"_test = [] {
+        expect(that % digits.size() == 256u);
+        expect(parse("42") == 42);
+    };
+
+    return 0;
+}
@@ -1,5 +1,9 @@
 #include <han/maybe.hh>
+#include <han/testing/lifecycle_counter.hh>
 #include <boost/ut.hpp>
+#include <string_view>
+#include <memory>
+#include <mutex>
 
 template <typename T>
 auto helper(bool present, T&& value) -> han::maybe<T> {
@@ -8,35 +12,54 @@ auto helper(bool present, T&& value) -> han::maybe<T> {
 }
 
 class mocker {
+    han::testing::lifecycle_counter counter;
     std::string expected;
-    std::string copies;
+    std::string expected_moves;
 
-    mocker(std::string expected_): expected(std::move(expected_)) {}
+    mocker(std::string expected_, std::string expected_moves_)
+        : expected(std::move(expected_)), expected_moves(std::move(expected_moves_)) {}
 
 public:
-    struct mocked {
-        mocker& log;
-        char x = 'z';
-
-        mocked(mocker& log_, char x_): log(log_), x(x_) {}
-        mocked(const mocked& o): log(o.log), x(o.x) { log.copy(x); }
-        mocked(mocked&& o): log(o.log) { std::swap(x, o.x); }
-    };
+    using mocked = han::testing::tracked;
 
     ~mocker() {
-        boost::ut::expect(boost::ut::that % expected == copies);
+        boost::ut::expect(boost::ut::that % expected == counter.copied());
+        boost::ut::expect(boost::ut::that % expected_moves == counter.moved());
     }
 
-    static inline auto expect_copies(std::string what) {
-        return mocker(std::move(what));
+    static inline auto expect_copies_and_moves(std::string copied, std::string moved) {
+        return mocker(std::move(copied), std::move(moved));
     }
 
-    auto mock(char x) { return mocked{*this, x}; }
+    auto mock(char x) { return counter.make(x); }
+    auto log() -> han::testing::lifecycle_counter& { return counter; }
+};
+
+struct pinned {
+    std::mutex lock;
+    int value;
+
+    explicit pinned(int value_): value(value_) {}
+};
+
+// A tracked value that is empty when its tag is '-', so maybe keeps it in
+// niche storage.
+struct niche_tracked {
+    han::testing::tracked value;
+
+    niche_tracked(han::testing::lifecycle_counter& counter, char tag): value(counter, tag) {}
+};
+
+inline auto empties = han::testing::lifecycle_counter{};
 
-private:
-    auto copy(char x) -> void { copies += x; }
+template <>
+struct han::niche_traits<niche_tracked> {
+    static auto empty() -> niche_tracked { return {empties, '-'}; }
+    static auto is_empty(const niche_tracked& x) noexcept -> bool { return x.value.tag() == '-'; }
 };
 
+static_assert(han::has_niche_v<niche_tracked>);
+
 auto main() -> int {
     using namespace boost::ut;
     using namespace std::literals;
@@ -44,58 +67,58 @@ auto main() -> int {
     "[copies in or_else()]"_test = [] {
         "lvalue a, lvalue b"_test = [] {
             "value present, copy a"_test = [] {
-                auto m = mocker::expect_copies("a");
+                auto m = mocker::expect_copies_and_moves("a", "aa");
                 auto a = helper(true, m.mock('a'));
                 auto b = m.mock('b');
-                expect(that % a.or_else(b).x == 'a');
+                expect(that % a.or_else(b).tag() == 'a');
             };
             "value missing, copy b"_test = [] {
-                auto m = mocker::expect_copies("b");
+                auto m = mocker::expect_copies_and_moves("b", "");
                 auto a = helper(false, m.mock('a'));
                 auto b = m.mock('b');
-                expect(that % a.or_else(b).x == 'b');
+                expect(that % a.or_else(b).tag() == 'b');
             };
         };
         "lvalue a, rvalue b"_test = [] {
             "value present, copy a"_test = [] {
-                auto m = mocker::expect_copies("a");
+                auto m = mocker::expect_copies_and_moves("a", "aa");
                 auto a = helper(true, m.mock('a'));
                 auto b = m.mock('b');
-                expect(that % a.or_else(std::move(b)).x == 'a');
+                expect(that % a.or_else(std::move(b)).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto b = m.mock('b');
-                expect(that % a.or_else(std::move(b)).x == 'b');
+                expect(that % a.or_else(std::move(b)).tag() == 'b');
             };
         };
         "rvalue a, lvalue b"_test = [] {
             "value present, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "aaa");
                 auto a = helper(true, m.mock('a'));
                 auto b = m.mock('b');
-                expect(that % std::move(a).or_else(b).x == 'a');
+                expect(that % std::move(a).or_else(b).tag() == 'a');
             };
             "value missing, copy b"_test = [] {
-                auto m = mocker::expect_copies("b");
+                auto m = mocker::expect_copies_and_moves("b", "");
                 auto a = helper(false, m.mock('a'));
                 auto b = m.mock('b');
-                expect(that % std::move(a).or_else(b).x == 'b');
+                expect(that % std::move(a).or_else(b).tag() == 'b');
             };
         };
         "rvalue a, rvalue b"_test = [] {
             "value present, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "aaa");
                 auto a = helper(true, m.mock('a'));
                 auto b = m.mock('b');
-                expect(that % std::move(a).or_else(std::move(b)).x == 'a');
+                expect(that % std::move(a).or_else(std::move(b)).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto b = m.mock('b');
-                expect(that % std::move(a).or_else(std::move(b)).x == 'b');
+                expect(that % std::move(a).or_else(std::move(b)).tag() == 'b');
             };
         };
     };
@@ -103,76 +126,85 @@ auto main() -> int {
     "[copies in then_do()]"_test = [] {
         "lvalue a"_test = [] {
             "value present, copy a"_test = [] {
-                auto m = mocker::expect_copies("a");
+                auto m = mocker::expect_copies_and_moves("a", "aaaa");
                 auto a = helper(true, m.mock('a'));
                 auto b = m.mock('b');
                 auto val = a.then_do([](auto&& x){ return std::move(x); });
-                expect(that % std::move(val).or_else(b).x == 'a');
+                expect(that % std::move(val).or_else(b).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto b = m.mock('b');
                 auto val = a.then_do([](auto&& x){ return std::move(x); });
-                expect(that % std::move(val).or_else(std::move(b)).x == 'b');
+                expect(that % std::move(val).or_else(std::move(b)).tag() == 'b');
             };
         };
         "rvalue a"_test = [] {
             "value present, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "aaaaa");
                 auto a = helper(true, m.mock('a'));
                 auto b = m.mock('b');
                 auto val = std::move(a).then_do([](auto&& x){ return std::move(x); });
-                expect(that % std::move(val).or_else(b).x == 'a');
+                expect(that % std::move(val).or_else(b).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto b = m.mock('b');
                 auto val = std::move(a).then_do([](auto&& x){ return std::move(x); });
-                expect(that % std::move(val).or_else(std::move(b)).x == 'b');
+                expect(that % std::move(val).or_else(std::move(b)).tag() == 'b');
             };
         };
     };
 
     "[copies in then_do() of void(...)]"_test = [] {
         "lvalue a"_test = [] {
-            "value present, copy a"_test = [] {
-                auto m = mocker::expect_copies("a");
+            "value present, no copies"_test = [] {
+                auto m = mocker::expect_copies_and_moves("", "aa");
                 auto a = helper(true, m.mock('a'));
-                auto b = m.mock('b');
                 auto extracted = '\0';
-                auto val = a.then_do([&](auto&& x){ extracted = x.x; });
-                expect(that % std::move(val).or_else(b).x == 'a');
+                auto& val = a.then_do([&](auto&& x){ extracted = x.tag(); });
+                expect(&val == &a);
                 expect(that % extracted == 'a');
             };
+            "chained, value present, no copies"_test = [] {
+                auto m = mocker::expect_copies_and_moves("", "aa");
+                auto a = helper(true, m.mock('a'));
+                auto extracted = ""s;
+                a.then_do([&](auto&& x){ extracted += x.tag(); })
+                 .then_do([&](auto&& x){ extracted += x.tag(); })
+                 .or_else_do([&]{ extracted += '!'; })
+                 .then_do([&](auto&& x){ extracted += x.tag(); });
+                expect(that % extracted == "aaa"s);
+            };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto b = m.mock('b');
                 auto extracted = '\0';
-                auto val = a.then_do([&](auto&& x){ extracted = x.x; });
-                expect(that % std::move(val).or_else(std::move(b)).x == 'b');
+                auto val = a.then_do([&](auto&& x){ extracted = x.tag(); });
+                expect(that % std::move(val).or_else(std::move(b)).tag() == 'b');
                 expect(that % extracted == '\0');
             };
         };
         "rvalue a"_test = [] {
             "value present, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "aaaa");
                 auto a = helper(true, m.mock('a'));
                 auto b = m.mock('b');
                 auto extracted = '\0';
-                auto val = std::move(a).then_do([&](auto&& x){ extracted = x.x; });
-                expect(that % std::move(val).or_else(b).x == 'a');
+                auto val = std::move(a).then_do([&](auto&& x){ extracted = x.tag(); });
+                expect(that % std::move(val).or_else(b).tag() == 'a');
                 expect(that % extracted == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto b = m.mock('b');
                 auto extracted = '\0';
-                auto val = std::move(a).then_do([&](auto&& x){ extracted = x.x; });
-                expect(that % std::move(val).or_else(std::move(b)).x == 'b');
+                auto val = std::move(a).then_do([&](auto&& x){ extracted = x.tag(); });
+                expect(that % std::move(val).or_else(std::move(b)).tag() == 'b');
                 expect(that % extracted == '\0');
             };
         };
@@ -180,122 +212,332 @@ auto main() -> int {
     "[copies in or_else_do()]"_test = [] {
         "lvalue a"_test = [] {
             "value present, copy a"_test = [] {
-                auto m = mocker::expect_copies("a");
+                auto m = mocker::expect_copies_and_moves("a", "aaa");
                 auto a = helper(true, m.mock('a'));
                 auto val = a.or_else_do([&]{ return m.mock('b'); });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'a');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "bb");
                 auto a = helper(false, m.mock('a'));
                 auto val = a.or_else_do([&]{ return m.mock('b'); });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'b');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'b');
             };
         };
         "rvalue a"_test = [] {
             "value present, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "aaaa");
                 auto a = helper(true, m.mock('a'));
                 auto val = std::move(a).or_else_do([&]{ return m.mock('b'); });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'a');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "bb");
                 auto a = helper(false, m.mock('a'));
                 auto val = std::move(a).or_else_do([&]{ return m.mock('b'); });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'b');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'b');
             };
         };
     };
     "[copies in or_else_do() with void()]"_test = [] {
         "lvalue a"_test = [] {
-            "value present, copy a"_test = [] {
-                auto m = mocker::expect_copies("a");
+            "value present, no copies"_test = [] {
+                auto m = mocker::expect_copies_and_moves("", "aa");
                 auto a = helper(true, m.mock('a'));
-                auto val = a.or_else_do([]{});
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'a');
+                auto& val = a.or_else_do([]{});
+                expect(&val == &a);
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto val = a.or_else_do([]{});
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'b');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'b');
             };
         };
         "rvalue a"_test = [] {
             "value present, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "aaaa");
                 auto a = helper(true, m.mock('a'));
                 auto val = std::move(a).or_else_do([]{});
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'a');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto val = std::move(a).or_else_do([]{});
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'b');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'b');
             };
         };
     };
     "[copies in then_maybe()]"_test = [] {
         "lvalue a"_test = [] {
             "value present, copy a"_test = [] {
-                auto m = mocker::expect_copies("a");
+                auto m = mocker::expect_copies_and_moves("a", "aaaa");
                 auto a = helper(true, m.mock('a'));
                 auto val = a.then_maybe([](auto&& x) { return han::maybe{std::move(x)}; });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'a');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto val = a.then_maybe([](auto&& x) { return han::maybe{std::move(x)}; });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'b');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'b');
             };
         };
         "rvalue a"_test = [] {
             "value present, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "aaaaa");
                 auto a = helper(true, m.mock('a'));
                 auto val = std::move(a).then_maybe([](auto&& x) { return han::maybe{std::move(x)}; });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'a');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "b");
                 auto a = helper(false, m.mock('a'));
                 auto val = std::move(a).then_maybe([](auto&& x) { return han::maybe{std::move(x)}; });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'b');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'b');
             };
         };
     };
     "[copies in or_maybe()]"_test = [] {
         "lvalue a"_test = [] {
             "value present, copy a"_test = [] {
-                auto m = mocker::expect_copies("a");
+                auto m = mocker::expect_copies_and_moves("a", "aaa");
                 auto a = helper(true, m.mock('a'));
                 auto val = a.or_maybe([&]{ return han::maybe{m.mock('b')}; });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'a');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "bb");
                 auto a = helper(false, m.mock('a'));
                 auto val = a.or_maybe([&]{ return han::maybe{m.mock('b')}; });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'b');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'b');
             };
         };
         "rvalue a"_test = [] {
             "value present, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "aaaa");
                 auto a = helper(true, m.mock('a'));
                 auto val = std::move(a).or_maybe([&]{ return han::maybe{m.mock('b')}; });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'a');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'a');
             };
             "value missing, no copies"_test = [] {
-                auto m = mocker::expect_copies("");
+                auto m = mocker::expect_copies_and_moves("", "bb");
                 auto a = helper(false, m.mock('a'));
                 auto val = std::move(a).or_maybe([&]{ return han::maybe{m.mock('b')}; });
-                expect(that % std::move(val).or_else(m.mock('b')).x == 'b');
+                expect(that % std::move(val).or_else(m.mock('b')).tag() == 'b');
             };
         };
     };
+    "[copies in maybe<T&>]"_test = [] {
+        "then_do(), then_maybe(), or_else() and or_maybe() copy nothing"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "");
+            auto a = m.mock('a');
+            auto b = m.mock('b');
+            auto ref = han::maybe<mocker::mocked&>{a};
+            auto extracted = '\0';
+            auto val = ref
+                .then_do([&](auto& x) { extracted = x.tag(); })
+                .then_maybe([](auto& x) { return han::maybe<const mocker::mocked&>{x}; })
+                .or_maybe([&] { return han::maybe<const mocker::mocked&>{b}; });
+            expect(that % extracted == 'a');
+            expect(that % val.or_else(b).tag() == 'a');
+        };
+        "value missing, no copies"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "");
+            auto b = m.mock('b');
+            auto ref = han::maybe<mocker::mocked&>{};
+            auto val = ref
+                .then_maybe([](auto& x) { return han::maybe<mocker::mocked&>{x}; })
+                .or_maybe([&] { return han::maybe<mocker::mocked&>{b}; });
+            expect(that % val.or_else(b).tag() == 'b');
+        };
+    };
+    "[copies in as_ref()]"_test = [] {
+        "value present, no copies"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "aa");
+            auto a = helper(true, m.mock('a'));
+            auto b = m.mock('b');
+            auto ref = a.as_ref();
+            static_assert(std::is_same_v<decltype(ref), han::maybe<mocker::mocked&>>);
+            expect(&ref.or_else(b) != &b);
+            expect(that % std::as_const(a).as_ref().or_else(b).tag() == 'a');
+        };
+        "value missing, no copies"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "");
+            auto a = helper(false, m.mock('a'));
+            auto b = m.mock('b');
+            expect(&a.as_ref().or_else(b) == &b);
+        };
+    };
+    "[side effects on move-only values]"_test = [] {
+        auto a = han::maybe{std::make_unique<int>(5)};
+        auto seen = 0;
+        a.then_do([&](const auto& x) { seen += *x; })
+         .or_else_do([&] { seen = -1; })
+         .then_do([&](const auto& x) { seen += *x; });
+        expect(that % seen == 10);
+        auto b = std::move(a).then_do([&](const auto& x) { seen += *x; });
+        expect(that % seen == 15);
+        expect(that % b.as_ref().then_do([](auto& x) { return *x; }).or_else(0) == 5);
+    };
+    "[lifecycle_counter]"_test = [] {
+        using han::testing::lifecycle_counts;
+        auto counter = han::testing::lifecycle_counter{};
+        {
+            auto a = han::make_maybe<han::testing::tracked>(counter, 'a');
+            auto b = counter.make('b');
+            auto c = a.or_else(b);
+            auto d = std::move(a).or_else(std::move(b));
+            expect(that % c.tag() == 'a');
+            expect(that % d.tag() == 'a');
+        }
+        expect(that % counter.totals('a') == lifecycle_counts{1, 1, 1, 0, 0, 3});
+        expect(that % counter.destroyed_moved_from('a') == 1u);
+        expect(that % counter.totals('b') == lifecycle_counts{1, 0, 0, 0, 0, 1});
+        expect(that % counter.totals().destructions == 4u);
+        expect(that % counter.copied() == "a"s);
+        expect(that % counter.moved() == "a"s);
+
+        auto in_maybe = lifecycle_counts{};
+        for (const auto& [site, counts] : counter.by_site()) {
+            if (std::string_view{site.file}.find("maybe.hh") != std::string_view::npos) in_maybe += counts;
+        }
+        expect(that % in_maybe.copies == 1u);
+        expect(that % in_maybe.moves == 1u);
+
+        auto all_sites = lifecycle_counts{};
+        for (const auto& entry : counter.by_site()) all_sites += entry.second;
+        expect(that % all_sites == counter.totals());
+    };
+    "[emplace() builds niche payloads in place]"_test = [] {
+        using han::testing::lifecycle_counts;
+        auto counter = han::testing::lifecycle_counter{};
+        {
+            auto m = han::make_maybe<niche_tracked>(counter, 'a');
+            m.emplace(counter, 'b');
+            expect(that % m.then_do([](const niche_tracked& x) { return x.value.tag(); }).or_else('-') == 'b');
+        }
+        expect(that % counter.totals('a') == lifecycle_counts{1, 0, 0, 0, 0, 1});
+        expect(that % counter.totals('b') == lifecycle_counts{1, 0, 0, 0, 0, 1});
+        expect(counter.moved().empty());
+    };
+    "[moved-from tracked objects keep their tag]"_test = [] {
+        using han::testing::lifecycle_counts;
+        auto counter = han::testing::lifecycle_counter{};
+        {
+            auto a = counter.make('a');
+            auto b = std::move(a);
+            expect(a.moved_from());
+            expect(that % a.tag() == 'a');
+            a = counter.make('c');
+            expect(!a.moved_from());
+            expect(that % b.tag() == 'a');
+        }
+        expect(that % counter.totals('a') == lifecycle_counts{1, 0, 1, 0, 0, 1});
+        expect(that % counter.totals('c') == lifecycle_counts{1, 0, 0, 0, 1, 2});
+        expect(that % counter.destroyed_moved_from('a') == 0u);
+        expect(that % counter.destroyed_moved_from('c') == 1u);
+    };
+    "[lifecycle_counter attributes assignments and destructions to the constructing site]"_test = [] {
+        auto counter = han::testing::lifecycle_counter{};
+        auto site = han::testing::call_site::current();
+        {
+            auto a = counter.make('a', site);
+            auto b = counter.make('b');
+            a = b;
+            a = std::move(b);
+        }
+        auto counts = counter.by_site().at(site);
+        expect(that % counts.constructions == 1u);
+        expect(that % counts.copy_assignments == 1u);
+        expect(that % counts.move_assignments == 1u);
+        expect(that % counts.destructions == 1u);
+    };
+    "[copies in in-place construction]"_test = [] {
+        "value constructor, one move"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "a");
+            auto a = han::maybe<mocker::mocked>{m.mock('a')};
+            expect(that % a.then_do([](auto&& x) { return x.tag(); }).or_else('b') == 'a');
+        };
+        "in_place constructor, no copies, no moves"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "");
+            auto a = han::maybe<mocker::mocked>{std::in_place, m.log(), 'a'};
+            expect(that % a.then_do([](auto&& x) { return x.tag(); }).or_else('b') == 'a');
+        };
+        "make_maybe(), no copies, no moves"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "");
+            auto a = han::make_maybe<mocker::mocked>(m.log(), 'a');
+            expect(that % a.then_do([](auto&& x) { return x.tag(); }).or_else('b') == 'a');
+        };
+        "emplace(), no copies, no moves"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "");
+            auto a = han::maybe<mocker::mocked>{};
+            expect(that % a.emplace(m.log(), 'a').tag() == 'a');
+            expect(that % a.emplace(m.log(), 'c').tag() == 'c');
+            expect(that % a.then_do([](auto&& x) { return x.tag(); }).or_else('b') == 'c');
+        };
+        "non-movable types"_test = [] {
+            auto a = han::make_maybe<pinned>(5);
+            auto b = han::maybe<pinned>{std::in_place, 6};
+            auto c = han::maybe<pinned>{};
+            c.emplace(7);
+            auto value = [](const pinned& x) { return x.value; };
+            expect(that % a.then_do(value).or_else(0) == 5);
+            expect(that % b.then_do(value).or_else(0) == 6);
+            expect(that % c.then_do(value).or_else(0) == 7);
+        };
+    };
+    "[copies in assignment and swap()]"_test = [] {
+        "move-assign, both present, no copies"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "aabba");
+            auto a = helper(true, m.mock('a'));
+            auto b = helper(true, m.mock('b'));
+            b = std::move(a);
+            expect(that % b.then_do([](auto&& x) { return x.tag(); }).or_else('c') == 'a');
+            expect(that % m.log().totals().move_assignments == 1u);
+            expect(that % m.log().totals().copy_assignments == 0u);
+        };
+        "move-assign into missing, no copies"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "aaa");
+            auto a = helper(true, m.mock('a'));
+            auto b = han::maybe<mocker::mocked>{};
+            b = std::move(a);
+            expect(that % b.then_do([](auto&& x) { return x.tag(); }).or_else('c') == 'a');
+            expect(that % m.log().totals().copy_assignments == 0u);
+        };
+        "copy-assign copies once"_test = [] {
+            auto m = mocker::expect_copies_and_moves("a", "aabb");
+            auto a = helper(true, m.mock('a'));
+            auto b = helper(true, m.mock('b'));
+            b = a;
+            expect(that % m.log().totals('a').copy_assignments == 1u);
+        };
+        "swap(), both present, no copies"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "aabbaba");
+            auto a = helper(true, m.mock('a'));
+            auto b = helper(true, m.mock('b'));
+            swap(a, b);
+            expect(that % a.then_do([](auto&& x) { return x.tag(); }).or_else('c') == 'b');
+            expect(that % b.then_do([](auto&& x) { return x.tag(); }).or_else('c') == 'a');
+            expect(that % m.log().totals().copy_assignments == 0u);
+        };
+        "swap(), one present, no copies"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "aaa");
+            auto a = helper(true, m.mock('a'));
+            auto b = han::maybe<mocker::mocked>{};
+            a.swap(b);
+            expect(that % a.then_do([](auto&& x) { return x.tag(); }).or_else('c') == 'c');
+            expect(that % b.then_do([](auto&& x) { return x.tag(); }).or_else('c') == 'a');
+            expect(that % m.log().totals().copy_assignments == 0u);
+        };
+        "reset(), no copies"_test = [] {
+            auto m = mocker::expect_copies_and_moves("", "aa");
+            auto a = helper(true, m.mock('a'));
+            a.reset();
+            expect(that % a.then_do([](auto&& x) { return x.tag(); }).or_else('c') == 'c');
+            expect(that % (m.log().totals('a').destructions - m.log().destroyed_moved_from('a')) == 1u);
+        };
+    };
     return 0;
 }
@@ -0,0 +1,161 @@
+#include <han/coroutine.hh>
+#include <boost/ut.hpp>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace {
+    auto lookup(const std::map<std::string, std::string>& table, const std::string& key) -> han::maybe<std::string> {
+        if (auto it = table.find(key); it != table.end()) return han::maybe{it->second};
+        else return std::nullopt;
+    }
+
+    const auto links = std::map<std::string, std::string>{{"a", "b"}, {"b", "c"}, {"c", "d"}, {"x", "y"}};
+
+    auto follow_three(std::string key) -> han::maybe<std::string> {
+        auto first = co_await lookup(links, key);
+        auto second = co_await lookup(links, first);
+        co_return co_await lookup(links, second);
+    }
+
+    struct guard {
+        int& destroyed;
+
+        ~guard() { ++destroyed; }
+    };
+
+    auto stops_at_empty(int& destroyed, int& reached, han::maybe<int> m) -> han::maybe<int> {
+        auto g = guard{destroyed};
+        auto x = co_await m;
+        ++reached;
+        co_return x + 1;
+    }
+
+    struct allocations {
+        int made = 0;
+        int freed = 0;
+    };
+
+    template <typename T>
+    struct counting_allocator {
+        using value_type = T;
+
+        allocations* count;
+
+        explicit counting_allocator(allocations& c) noexcept: count(&c) {}
+
+        template <typename U>
+        counting_allocator(const counting_allocator<U>& other) noexcept: count(other.count) {}
+
+        auto allocate(std::size_t n) -> T* {
+            ++count->made;
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        auto deallocate(T* p, std::size_t n) noexcept -> void {
+            ++count->freed;
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        friend auto operator==(const counting_allocator& a, const counting_allocator& b) noexcept -> bool {
+            return a.count == b.count;
+        }
+    };
+
+    auto half(std::allocator_arg_t, counting_allocator<int>, int x) -> han::maybe<int> {
+        auto even = x % 2 == 0 ? han::maybe{x} : han::maybe<int>{};
+        co_return co_await even / 2;
+    }
+
+    struct scaler {
+        int factor;
+
+        auto scale(std::allocator_arg_t, counting_allocator<int>, han::maybe<int> m) const -> han::maybe<int> {
+            co_return co_await m * factor;
+        }
+    };
+}
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[co_await]"_test = [] {
+        "present values are unwrapped"_test = [] {
+            expect(follow_three("a") == "d"s);
+        };
+        "an empty maybe ends the coroutine"_test = [] {
+            expect(follow_three("x") == std::nullopt);
+            expect(follow_three("q") == std::nullopt);
+            auto destroyed = 0;
+            auto reached = 0;
+            expect(stops_at_empty(destroyed, reached, han::maybe<int>{}) == std::nullopt);
+            expect(that % reached == 0);
+            expect(that % destroyed == 1);
+            expect(stops_at_empty(destroyed, reached, han::maybe{1}) == 2);
+            expect(that % reached == 1);
+            expect(that % destroyed == 2);
+        };
+        "lvalues give references"_test = [] {
+            auto m = han::maybe{1};
+            auto bump = [&]() -> han::maybe<int> {
+                auto& x = co_await m;
+                co_return ++x;
+            };
+            expect(bump() == 2);
+            expect(m == 2);
+            auto target = 5;
+            auto via_ref = [&]() -> han::maybe<int> {
+                auto& x = co_await han::maybe<int&>{target};
+                x = 6;
+                co_return x;
+            };
+            expect(via_ref() == 6);
+            expect(that % target == 6);
+        };
+        "rvalues are moved"_test = [] {
+            auto owner = []() -> han::maybe<int> {
+                auto p = co_await han::maybe{std::make_unique<int>(7)};
+                co_return *p;
+            };
+            expect(owner() == 7);
+        };
+        "co_return"_test = [] {
+            auto empty = []() -> han::maybe<std::string> { co_return std::nullopt; };
+            auto whole = []() -> han::maybe<std::string> { co_return han::maybe{"m"s}; };
+            auto built = []() -> han::maybe<std::string> { co_return "c"; };
+            expect(empty() == std::nullopt);
+            expect(whole() == "m"s);
+            expect(built() == "c"s);
+        };
+    };
+
+    "[frame allocation]"_test = [] {
+        auto count = allocations{};
+        auto alloc = counting_allocator<int>{count};
+        expect(half(std::allocator_arg, alloc, 8) == 4);
+        expect(half(std::allocator_arg, alloc, 7) == std::nullopt);
+        expect(that % count.made == 2);
+        expect(that % count.freed == 2);
+        auto s = scaler{3};
+        expect(s.scale(std::allocator_arg, alloc, han::maybe{2}) == 6);
+        expect(s.scale(std::allocator_arg, alloc, han::maybe<int>{}) == std::nullopt);
+        expect(that % count.made == 4);
+        expect(that % count.freed == 4);
+    };
+
+#if defined(__cpp_exceptions)
+    "[exceptions]"_test = [] {
+        auto destroyed = 0;
+        auto fails = [&]() -> han::maybe<int> {
+            auto g = guard{destroyed};
+            co_await han::maybe{1};
+            throw 42;
+        };
+        expect(throws<int>([&] { static_cast<void>(fails()); }));
+        expect(that % destroyed == 1);
+    };
+#endif
+
+    return 0;
+}
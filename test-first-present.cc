@@ -0,0 +1,159 @@
+#include <han/first_present.hh>
+#include <boost/ut.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <string>
+#include <thread>
+
+namespace {
+    class gate {
+        std::mutex lock;
+        std::condition_variable opened;
+        bool open = false;
+
+    public:
+        auto wait() -> void {
+            auto guard = std::unique_lock{lock};
+            opened.wait(guard, [this] { return open; });
+        }
+
+        auto release() -> void {
+            {
+                auto guard = std::lock_guard{lock};
+                open = true;
+            }
+            opened.notify_all();
+        }
+    };
+}
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[first_present]"_test = [] {
+        "the first present alternative wins"_test = [] {
+            auto pool = han::thread_pool{3};
+            auto r = han::first_present(pool,
+                                        [] { return han::maybe<int>{}; },
+                                        [] { return han::maybe{2}; },
+                                        [] { return han::maybe{3}; });
+            expect(std::move(r).get() == 2);
+        };
+        "all empty"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto r = han::first_present(pool, [] { return han::maybe<std::string>{}; }, [] { return han::maybe<std::string>{}; });
+            expect(std::move(r).get() == std::nullopt);
+        };
+        "a single alternative"_test = [] {
+            auto pool = han::thread_pool{1};
+            expect(han::first_present(pool, [] { return han::maybe{"x"s}; }).get() == "x"s);
+        };
+    };
+
+    "[priority]"_test = [] {
+        "a slower alternative before a present one is waited for"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto g = gate{};
+            auto later = std::atomic<bool>{false};
+            auto r = han::first_present(pool,
+                                        [&] {
+                                            g.wait();
+                                            return han::maybe{1};
+                                        },
+                                        [&] {
+                                            later = true;
+                                            return han::maybe{2};
+                                        });
+            while (!later) std::this_thread::sleep_for(1ms);
+            expect(r.try_get() == std::nullopt);
+            g.release();
+            expect(std::move(r).get() == 1);
+        };
+        "slower alternatives after the answer are not waited for"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto g = gate{};
+            auto r = han::first_present(pool,
+                                        [] { return han::maybe{1}; },
+                                        [&] {
+                                            g.wait();
+                                            return han::maybe{2};
+                                        });
+            r.wait();
+            expect(r.try_get() == 1);
+            g.release();
+        };
+        "an empty alternative lets the next one answer"_test = [] {
+            auto pool = han::thread_pool{3};
+            auto g = gate{};
+            auto r = han::first_present(pool,
+                                        [] { return han::maybe<int>{}; },
+                                        [] { return han::maybe{2}; },
+                                        [&] {
+                                            g.wait();
+                                            return han::maybe{3};
+                                        });
+            expect(std::move(r).get() == 2);
+            g.release();
+        };
+    };
+
+    "[cancellation]"_test = [] {
+        "alternatives that haven't started are skipped"_test = [] {
+            auto pool = han::thread_pool{1};
+            auto calls = std::atomic<int>{0};
+            auto r = han::first_present(pool,
+                                        [] { return han::maybe{1}; },
+                                        [&] {
+                                            ++calls;
+                                            return han::maybe{2};
+                                        });
+            expect(std::move(r).get() == 1);
+            auto done = std::atomic<bool>{false};
+            pool.submit([&] { done = true; });
+            while (!done) std::this_thread::sleep_for(1ms);
+            expect(that % calls.load() == 0);
+        };
+        "running alternatives see the token"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto started = gate{};
+            auto gave_up = std::atomic<bool>{false};
+            auto r = han::first_present(pool,
+                                        [&] {
+                                            started.wait();
+                                            return han::maybe{1};
+                                        },
+                                        [&](const han::cancel_token& token) {
+                                            started.release();
+                                            while (!token.cancelled()) std::this_thread::sleep_for(1ms);
+                                            gave_up = true;
+                                            return han::maybe<int>{};
+                                        });
+            expect(std::move(r).get() == 1);
+            while (!gave_up) std::this_thread::sleep_for(1ms);
+            expect(gave_up.load());
+        };
+    };
+
+#if defined(__cpp_exceptions)
+    "[exceptions]"_test = [] {
+        "an exception counts where its alternative stands"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto r = han::first_present(pool,
+                                        [] { return han::maybe<int>{}; },
+                                        []() -> han::maybe<int> { throw std::runtime_error{"down"}; });
+            expect(throws<std::runtime_error>([&] { static_cast<void>(std::move(r).get()); }));
+        };
+        "an answer before it hides it"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto r = han::first_present(pool,
+                                        [] { return han::maybe{1}; },
+                                        []() -> han::maybe<int> { throw std::runtime_error{"down"}; });
+            expect(std::move(r).get() == 1);
+        };
+    };
+#endif
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <han/future.hh>
+#include <boost/ut.hpp>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+    // Blocks a pool's only worker until released, so a test can look at a
+    // future before its value exists.
+    class gate {
+        std::mutex lock;
+        std::condition_variable opened;
+        bool open = false;
+
+    public:
+        auto wait() -> void {
+            auto guard = std::unique_lock{lock};
+            opened.wait(guard, [this] { return open; });
+        }
+
+        auto release() -> void {
+            {
+                auto guard = std::lock_guard{lock};
+                open = true;
+            }
+            opened.notify_all();
+        }
+    };
+}
+
+static_assert(!std::is_copy_constructible_v<han::maybe_future<int>>);
+static_assert(!std::is_copy_assignable_v<han::maybe_future<int>>);
+static_assert(std::is_nothrow_move_constructible_v<han::maybe_future<int>>);
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[async]"_test = [] {
+        auto pool = han::thread_pool{2};
+        expect(han::async(pool, [] { return 6 * 7; }).get() == 42);
+        expect(han::async(pool, [] { return han::maybe{"x"s}; }).get() == "x"s);
+        expect(han::async(pool, [] { return han::maybe<int>{}; }).get() == std::nullopt);
+        expect(han::async(pool, [&] { return han::async(pool, [] { return 1; }); }).get() == 1);
+    };
+
+    "[try_get]"_test = [] {
+        auto pool = han::thread_pool{1};
+        auto g = gate{};
+        auto f = han::async(pool, [&] {
+            g.wait();
+            return 5;
+        });
+        expect(!f.ready());
+        expect(f.try_get() == std::nullopt);
+        g.release();
+        f.wait();
+        expect(f.ready());
+        expect(f.try_get() == 5);
+        expect(f.try_get() == 5);
+    };
+
+    "[continuations]"_test = [] {
+        "chains"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto n = han::async(pool, [] { return "12"s; })
+                         .then_do([](const std::string& s) { return std::stoi(s); })
+                         .then_maybe([](int x) { return x > 10 ? han::maybe{x * 2} : han::maybe<int>{}; })
+                         .get();
+            expect(n == 24);
+        };
+        "an empty value skips to or_maybe"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto calls = std::atomic<int>{0};
+            auto r = han::async(pool, [] { return han::maybe<int>{}; })
+                         .then_do([&](int x) { ++calls; return x; })
+                         .or_maybe([] { return han::maybe{7}; })
+                         .get();
+            expect(r == 7);
+            expect(that % calls.load() == 0);
+        };
+        "asynchronous fallbacks"_test = [] {
+            auto pool = han::thread_pool{2};
+            auto r = han::async(pool, [] { return han::maybe<int>{}; })
+                         .or_maybe([&] { return han::async(pool, [] { return 3; }); })
+                         .then_maybe([&](int x) { return han::async(pool, [x] { return x + 1; }); })
+                         .get();
+            expect(r == 4);
+        };
+        "a ready value runs continuations inline"_test = [] {
+            auto caller = std::this_thread::get_id();
+            auto ran_on = std::thread::id{};
+            auto f = han::maybe_future<int>{han::maybe{1}}.then_do([&](int x) {
+                ran_on = std::this_thread::get_id();
+                return x + 1;
+            });
+            expect(ran_on == caller);
+            expect(f.try_get() == 2);
+        };
+        "a pending value runs continuations where it is set"_test = [] {
+            auto pool = han::thread_pool{1};
+            auto g = gate{};
+            auto worker = std::thread::id{};
+            auto ran_on = std::thread::id{};
+            auto f = han::async(pool, [&] {
+                g.wait();
+                worker = std::this_thread::get_id();
+                return 1;
+            });
+            auto next = std::move(f).then_do([&](int) { ran_on = std::this_thread::get_id(); });
+            g.release();
+            std::move(next).get();
+            expect(ran_on == worker);
+            expect(ran_on != std::this_thread::get_id());
+        };
+    };
+
+    "[work stealing]"_test = [] {
+        auto pool = han::thread_pool{4};
+        auto count = std::atomic<int>{0};
+        auto done = std::vector<han::maybe_future<int>>{};
+        for (auto i = 0; i < 64; ++i)
+            done.push_back(han::async(pool, [&pool, &count] {
+                for (auto j = 0; j < 8; ++j) pool.submit([&count] { ++count; });
+                return 0;
+            }));
+        for (auto& f : done) f.wait();
+        while (count.load() != 64 * 8) std::this_thread::sleep_for(1ms);
+        expect(that % count.load() == 64 * 8);
+    };
+
+#if defined(__cpp_exceptions)
+    "[exceptions]"_test = [] {
+        auto pool = han::thread_pool{1};
+        auto f = han::async(pool, []() -> int { throw std::runtime_error{"lost"}; }).then_do([](int x) { return x; });
+        expect(throws<std::runtime_error>([&] { static_cast<void>(std::move(f).get()); }));
+    };
+#endif
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <han/lazy.hh>
+#include <boost/ut.hpp>
+#include <string>
+#include <string_view>
+
+template <typename T>
+auto helper(bool present, T&& value) -> han::maybe<T> {
+    if (present) return han::maybe{std::forward<T>(value)};
+    else return std::nullopt;
+}
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[lazy(maybe)::then_do()]"_test = [] {
+        "value present"_test = [] {
+            auto value = han::lazy(helper(true, 5))
+                .then_do([](int x) { return x * 3; })
+                .then_do([](int x) { return x + 1; })
+                .then_do([](int x) { return std::to_string(x); });
+            expect(that % std::move(value).or_else("none"s) == "16"s);
+        };
+        "value missing"_test = [] {
+            auto value = han::lazy(helper(false, 5))
+                .then_do([](int x) { return x * 3; })
+                .then_do([](int x) { return std::to_string(x); });
+            expect(that % std::move(value).or_else("none"s) == "none"s);
+        };
+        "with void(T) steps"_test = [] {
+            auto seen = 0;
+            auto value = han::lazy(helper(true, 5))
+                .then_do([&](int x) { seen += x; })
+                .then_do([](int x) { return x * 3; })
+                .then_do([&](int x) { seen += x; })
+                .or_else(0);
+            expect(that % value == 15);
+            expect(that % seen == 20);
+        };
+    };
+
+    "[lazy(maybe) runs nothing before the terminal operation]"_test = [] {
+        auto calls = 0;
+        auto chain = han::lazy(helper(true, 5))
+            .then_do([&](int x) { ++calls; return x + 1; })
+            .then_maybe([&](int x) { ++calls; return han::maybe{x * 2}; });
+        expect(that % calls == 0);
+        expect(that % chain.or_else(0) == 12);
+        expect(that % calls == 2);
+        expect(that % std::move(chain).eval().or_else(0) == 12);
+        expect(that % calls == 4);
+    };
+
+    "[lazy(maybe)::then_maybe()]"_test = [] {
+        auto half = [](int x) { return helper(x % 2 == 0, x / 2); };
+        "all steps present"_test = [&] {
+            auto value = han::lazy(helper(true, 6)).then_maybe(half).then_do([](int x) { return x + 1; }).then_maybe(half);
+            expect(that % std::move(value).or_else(0) == 2);
+        };
+        "intermediate step missing"_test = [&] {
+            auto calls = 0;
+            auto value = han::lazy(helper(true, 3))
+                .then_maybe(half)
+                .then_do([&](int x) { ++calls; return x; })
+                .or_else(0);
+            expect(that % value == 0);
+            expect(that % calls == 0);
+        };
+        "last step missing"_test = [&] {
+            auto value = han::lazy(helper(true, 6)).then_maybe(half).then_maybe(half);
+            expect(that % std::move(value).or_else(0) == 0);
+        };
+    };
+
+    "[lazy(maybe) terminal operations]"_test = [] {
+        "or_else_do()"_test = [] {
+            auto value = han::lazy(helper(false, 5)).then_do([](int x) { return x * 3; }).or_else_do([] { return 7; });
+            expect(that % value.or_else(0) == 7);
+        };
+        "or_maybe()"_test = [] {
+            auto value = han::lazy(helper(true, 5))
+                .then_maybe([](int) { return helper(false, 0); })
+                .or_maybe([] { return helper(true, 9); });
+            expect(that % value.or_else(0) == 9);
+        };
+        "eval() without steps"_test = [] {
+            expect(that % han::lazy(helper(true, 5)).eval().or_else(0) == 5);
+            expect(that % han::lazy(helper(false, 5)).eval().or_else(0) == 0);
+        };
+    };
+
+    "[lazy(maybe) of an lvalue]"_test = [] {
+        auto source = helper(true, "abc"s);
+        auto size = han::lazy(source).then_do([](const std::string& x) { return x.size(); }).or_else(0u);
+        expect(that % size == 3u);
+        expect(that % source.or_else(""s) == "abc"s);
+    };
+
+    "[lazy(maybe) treats a niche result as empty, like then_do()]"_test = [] {
+        static int values[] = {42, 7};
+        auto find = [](int i) -> int* { return i < 2 ? &values[i] : nullptr; };
+        auto deref = [](int* p) { return -*p; };
+        for (auto i : {0, 1, 5}) {
+            auto eager = han::maybe{i}.then_do(find).then_do(deref).or_else(-1);
+            auto lazy = han::lazy(han::maybe{i}).then_do(find).then_do(deref).or_else(-1);
+            expect(that % lazy == eager);
+        }
+        expect(that % han::lazy(han::maybe{5}).then_do(find).eval().then_do(deref).or_else(-1) == -1);
+        auto none = [](int) { return han::niche_traits<std::string_view>::empty(); };
+        auto size = [](std::string_view s) { return s.size() + 1; };
+        expect(that % han::maybe{5}.then_do(none).then_do(size).or_else(0u) == 0u);
+        expect(that % han::lazy(han::maybe{5}).then_do(none).then_do(size).or_else(0u) == 0u);
+    };
+
+    return 0;
+}
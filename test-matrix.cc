@@ -0,0 +1,169 @@
+#include <han/maybe.hh>
+#include <han/testing/lifecycle_counter.hh>
+#include <boost/ut.hpp>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using han::testing::tracked;
+
+enum class combinator { then_do, then_do_void, then_maybe, or_else_do, or_else_do_void, or_maybe };
+enum class category { lvalue, const_lvalue, rvalue };
+enum class presence { present, missing };
+enum class signature { none, value, const_ref, rvalue_ref };
+
+constexpr auto name(combinator c) -> const char* {
+    switch (c) {
+        case combinator::then_do: return "then_do(R(T))";
+        case combinator::then_do_void: return "then_do(void(T))";
+        case combinator::then_maybe: return "then_maybe()";
+        case combinator::or_else_do: return "or_else_do(T())";
+        case combinator::or_else_do_void: return "or_else_do(void())";
+        case combinator::or_maybe: return "or_maybe()";
+    }
+    return "";
+}
+
+constexpr auto name(category c) -> const char* {
+    switch (c) {
+        case category::lvalue: return "lvalue";
+        case category::const_lvalue: return "const lvalue";
+        case category::rvalue: return "rvalue";
+    }
+    return "";
+}
+
+constexpr auto name(presence p) -> const char* {
+    return p == presence::present ? "present" : "missing";
+}
+
+constexpr auto name(signature s) -> const char* {
+    switch (s) {
+        case signature::none: return "()";
+        case signature::value: return "(T)";
+        case signature::const_ref: return "(const T&)";
+        case signature::rvalue_ref: return "(T&&)";
+    }
+    return "";
+}
+
+constexpr auto takes_value(combinator c) -> bool {
+    return c == combinator::then_do || c == combinator::then_do_void || c == combinator::then_maybe;
+}
+
+// void then_do() keeps the value, so even on an rvalue its callable only gets an lvalue.
+constexpr auto applies(combinator c, category cat, signature s) -> bool {
+    if (!takes_value(c)) return s == signature::none;
+    if (s == signature::none) return false;
+    if (s == signature::rvalue_ref) return cat == category::rvalue && c != combinator::then_do_void;
+    return true;
+}
+
+struct counts {
+    std::size_t copies;
+    std::size_t moves;
+};
+
+// The model every case is checked against: a payload is copied only when the
+// source is an lvalue and something needs its own T, otherwise it is moved.
+constexpr auto expected(combinator c, category cat, presence p, signature s) -> counts {
+    auto present = p == presence::present;
+    auto rvalue = cat == category::rvalue;
+    switch (c) {
+        case combinator::then_do:
+        case combinator::then_maybe:
+            if (!present || s != signature::value) return {0, 0};
+            return rvalue ? counts{0, 1} : counts{1, 0};
+        case combinator::then_do_void:
+            return {present && s == signature::value ? 1u : 0u, present && rvalue ? 1u : 0u};
+        case combinator::or_else_do:
+            if (!present) return {0, 1};
+            return rvalue ? counts{0, 1} : counts{1, 0};
+        case combinator::or_else_do_void:
+            return {0, present && rvalue ? 1u : 0u};
+        case combinator::or_maybe:
+            if (!present) return {0, 0};
+            return rvalue ? counts{0, 1} : counts{1, 0};
+    }
+    return {0, 0};
+}
+
+template <signature S>
+auto callable() {
+    if constexpr (S == signature::value) return [](tracked x) { return x.tag(); };
+    else if constexpr (S == signature::const_ref) return [](const tracked& x) { return x.tag(); };
+    else return [](tracked&& x) { return x.tag(); };
+}
+
+template <signature S>
+auto side_effect(char& seen) {
+    if constexpr (S == signature::value) return [&seen](tracked x) { seen = x.tag(); };
+    else if constexpr (S == signature::const_ref) return [&seen](const tracked& x) { seen = x.tag(); };
+    else return [&seen](tracked&& x) { seen = x.tag(); };
+}
+
+template <combinator C, signature S, typename M>
+auto apply(M&& m, han::testing::lifecycle_counter& counter) -> void {
+    auto seen = ' ';
+    if constexpr (C == combinator::then_do) {
+        std::forward<M>(m).then_do(callable<S>());
+    } else if constexpr (C == combinator::then_do_void) {
+        std::forward<M>(m).then_do(side_effect<S>(seen));
+    } else if constexpr (C == combinator::then_maybe) {
+        std::forward<M>(m).then_maybe([f = callable<S>()](auto&& x) -> han::maybe<char> {
+            return han::maybe{f(std::forward<decltype(x)>(x))};
+        });
+    } else if constexpr (C == combinator::or_else_do) {
+        std::forward<M>(m).or_else_do([&] { return counter.make('b'); });
+    } else if constexpr (C == combinator::or_else_do_void) {
+        std::forward<M>(m).or_else_do([&] { seen = 'b'; });
+    } else {
+        std::forward<M>(m).or_maybe([&] { return han::make_maybe<tracked>(counter, 'b'); });
+    }
+}
+
+template <combinator C, category Cat, presence P, signature S>
+auto run() -> counts {
+    auto counter = han::testing::lifecycle_counter{};
+    auto m = P == presence::present ? han::make_maybe<tracked>(counter, 'a') : han::maybe<tracked>{};
+    counter.reset();
+    if constexpr (Cat == category::lvalue) apply<C, S>(m, counter);
+    else if constexpr (Cat == category::const_lvalue) apply<C, S>(std::as_const(m), counter);
+    else apply<C, S>(std::move(m), counter);
+    return {counter.totals().copies, counter.totals().moves};
+}
+
+template <typename E, E... Values, typename F>
+auto for_each(F f) -> void {
+    (f(std::integral_constant<E, Values>{}), ...);
+}
+
+auto main() -> int {
+    using namespace boost::ut;
+
+    for_each<combinator, combinator::then_do, combinator::then_do_void, combinator::then_maybe,
+             combinator::or_else_do, combinator::or_else_do_void, combinator::or_maybe>([](auto c) {
+        for_each<category, category::lvalue, category::const_lvalue, category::rvalue>([&](auto cat) {
+            for_each<presence, presence::present, presence::missing>([&](auto p) {
+                for_each<signature, signature::none, signature::value,
+                         signature::const_ref, signature::rvalue_ref>([&](auto s) {
+                    constexpr auto C = decltype(c)::value;
+                    constexpr auto Cat = decltype(cat)::value;
+                    constexpr auto P = decltype(p)::value;
+                    constexpr auto S = decltype(s)::value;
+                    if constexpr (applies(C, Cat, S)) {
+                        auto title = std::string{name(C)} + ", " + name(Cat) + ", " + name(P) + ", " + name(S);
+                        test(title) = [] {
+                            auto actual = run<C, Cat, P, S>();
+                            auto model = expected(C, Cat, P, S);
+                            expect(that % actual.copies == model.copies);
+                            expect(that % actual.moves == model.moves);
+                        };
+                    }
+                });
+            });
+        });
+    });
+
+    return 0;
+}
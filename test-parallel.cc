@@ -0,0 +1,105 @@
+#include <han/parallel.hh>
+#include <boost/ut.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    auto input(std::size_t size) -> std::vector<han::maybe<int>> {
+        auto result = std::vector<han::maybe<int>>{};
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            if (i % 3 != 0) result.emplace_back(static_cast<int>(i));
+            else result.emplace_back(std::nullopt);
+        }
+        return result;
+    }
+
+    auto values(const std::vector<han::maybe<int>>& maybes) -> std::vector<int> {
+        auto result = std::vector<int>{};
+        for (const auto& m : maybes) result.push_back(m.or_else(-1));
+        return result;
+    }
+
+    auto half = [](int x) { return x % 2 == 0 ? han::maybe{x / 2} : han::maybe<int>{}; };
+}
+
+auto main() -> int {
+    using namespace boost::ut;
+
+    for (auto threads : {std::size_t{1}, std::size_t{2}, std::size_t{5}}) {
+        for (auto size : {std::size_t{0}, std::size_t{1}, std::size_t{1000}, std::size_t{100003}}) {
+            test("[transform_maybe(thread_pool)]") = [=] {
+                auto pool = han::thread_pool{threads};
+                auto in = input(size);
+                auto expected = std::vector<han::maybe<int>>{};
+                for (const auto& m : in) expected.push_back(m.then_do([](int x) { return x * 2; }));
+                auto out = std::vector<han::maybe<int>>(size);
+                auto end = han::transform_maybe(pool, in.begin(), in.end(), out.begin(), [](int x) { return x * 2; });
+                expect(end == out.end());
+                expect(values(out) == values(expected));
+            };
+            test("[then_maybe_each(thread_pool)]") = [=] {
+                auto pool = han::thread_pool{threads};
+                auto in = input(size);
+                auto expected = std::vector<han::maybe<int>>{};
+                for (const auto& m : in) expected.push_back(m.then_maybe(half));
+                auto out = std::vector<han::maybe<int>>(size);
+                han::then_maybe_each(pool, in.begin(), in.end(), out.begin(), half);
+                expect(values(out) == values(expected));
+            };
+        }
+    }
+
+    "[transform_maybe() skips empty elements]"_test = [] {
+        auto pool = han::thread_pool{4};
+        auto in = input(10000);
+        auto calls = std::atomic<std::size_t>{0};
+        auto out = std::vector<han::maybe<int>>(in.size());
+        han::transform_maybe(pool, in.begin(), in.end(), out.begin(), [&](int x) { ++calls; return x; });
+        expect(that % calls.load() == std::size_t{6666});
+    };
+
+    "[transform_maybe() from every worker of the pool]"_test = [] {
+        for (auto threads : {std::size_t{1}, std::size_t{2}, std::size_t{4}}) {
+            auto pool = han::thread_pool{threads};
+            auto in = input(10000);
+            auto outs = std::vector<std::vector<han::maybe<int>>>(threads * 2, std::vector<han::maybe<int>>(in.size()));
+            auto finished = std::atomic<std::size_t>{0};
+            for (auto& out : outs)
+                pool.submit([&] {
+                    han::transform_maybe(pool, in.begin(), in.end(), out.begin(), [](int x) { return x + 1; });
+                    ++finished;
+                });
+            while (finished.load() != outs.size()) std::this_thread::yield();
+            for (const auto& out : outs) expect(out[1] == 2 && out[9999] == std::nullopt);
+        }
+    };
+
+#if defined(__cpp_exceptions)
+    "[transform_maybe() rethrows on the calling thread]"_test = [] {
+        auto pool = han::thread_pool{4};
+        auto in = input(10000);
+        auto out = std::vector<han::maybe<int>>(in.size());
+        expect(throws<std::runtime_error>([&] {
+            han::transform_maybe(pool, in.begin(), in.end(), out.begin(), [](int x) {
+                if (x == 9998) throw std::runtime_error{"bad"};
+                return x;
+            });
+        }));
+    };
+#endif
+
+#if defined(__cpp_lib_execution)
+    "[transform_maybe(std::execution::seq)]"_test = [] {
+        auto in = input(1000);
+        auto out = std::vector<han::maybe<int>>(in.size());
+        han::transform_maybe(std::execution::seq, in.begin(), in.end(), out.begin(), [](int x) { return x + 1; });
+        auto expected = std::vector<han::maybe<int>>{};
+        for (const auto& m : in) expected.push_back(m.then_do([](int x) { return x + 1; }));
+        expect(values(out) == values(expected));
+    };
+#endif
+
+    return 0;
+}
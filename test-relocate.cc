@@ -0,0 +1,89 @@
+#include <han/relocate.hh>
+#include <han/testing/lifecycle_counter.hh>
+#include <boost/ut.hpp>
+#include <memory>
+#include <string>
+
+struct handle {
+    static inline int moves = 0;
+    std::unique_ptr<int> value;
+
+    explicit handle(int x): value(std::make_unique<int>(x)) {}
+    handle(handle&& other) noexcept: value(std::move(other.value)) { ++moves; }
+};
+
+template <>
+struct han::is_trivially_relocatable<handle> : std::true_type {};
+
+static_assert(han::is_trivially_relocatable_v<han::maybe<int>>);
+static_assert(han::is_trivially_relocatable_v<han::maybe<double>>);
+static_assert(han::is_trivially_relocatable_v<han::maybe<int&>>);
+static_assert(han::is_trivially_relocatable_v<han::maybe<std::unique_ptr<int>>>);
+static_assert(han::is_trivially_relocatable_v<han::maybe<handle>>);
+static_assert(han::is_trivially_relocatable_v<const han::maybe<handle>>);
+static_assert(!han::is_trivially_relocatable_v<han::maybe<std::string>>);
+static_assert(!han::is_trivially_relocatable_v<han::maybe<han::testing::tracked>>);
+static_assert(han::is_nothrow_relocatable_v<han::maybe<std::string>>);
+
+template <typename T>
+struct buffer {
+    std::allocator<T> allocator;
+    T* data;
+    std::size_t size;
+
+    explicit buffer(std::size_t size_): data(allocator.allocate(size_)), size(size_) {}
+    ~buffer() { allocator.deallocate(data, size); }
+};
+
+auto main() -> int {
+    using namespace boost::ut;
+
+    "[relocate() copies bytes of trivially relocatable maybes]"_test = [] {
+        auto from = buffer<han::maybe<handle>>{4};
+        auto to = buffer<han::maybe<handle>>{4};
+        for (auto i = 0; i < 4; ++i) {
+            if (i % 2 == 0) new (from.data + i) han::maybe<handle>{std::in_place, i};
+            else new (from.data + i) han::maybe<handle>{};
+        }
+        handle::moves = 0;
+        auto end = han::relocate(from.data, from.data + 4, to.data);
+        expect(end == to.data + 4);
+        expect(that % handle::moves == 0);
+        auto value = [](const handle& h) { return *h.value; };
+        expect(that % to.data[0].then_do(value).or_else(-1) == 0);
+        expect(that % to.data[1].then_do(value).or_else(-1) == -1);
+        expect(that % to.data[2].then_do(value).or_else(-1) == 2);
+        expect(that % to.data[3].then_do(value).or_else(-1) == -1);
+        std::destroy(to.data, to.data + 4);
+    };
+
+    "[relocate() moves and destroys other maybes]"_test = [] {
+        auto counter = han::testing::lifecycle_counter{};
+        auto from = buffer<han::maybe<han::testing::tracked>>{3};
+        auto to = buffer<han::maybe<han::testing::tracked>>{3};
+        new (from.data) han::maybe<han::testing::tracked>{std::in_place, counter, 'a'};
+        new (from.data + 1) han::maybe<han::testing::tracked>{};
+        new (from.data + 2) han::maybe<han::testing::tracked>{std::in_place, counter, 'c'};
+        han::relocate(from.data, from.data + 3, to.data);
+        expect(that % counter.copied() == std::string{});
+        expect(that % counter.moved() == std::string{"ac"});
+        expect(that % counter.destroyed_moved_from('a') == 1u);
+        expect(that % counter.destroyed_moved_from('c') == 1u);
+        auto tag = [](const han::testing::tracked& x) { return x.tag(); };
+        expect(that % to.data[0].then_do(tag).or_else('-') == 'a');
+        expect(that % to.data[1].then_do(tag).or_else('-') == '-');
+        expect(that % to.data[2].then_do(tag).or_else('-') == 'c');
+        std::destroy(to.data, to.data + 3);
+    };
+
+    "[relocate_at()]"_test = [] {
+        auto from = buffer<han::maybe<std::string>>{1};
+        auto to = buffer<han::maybe<std::string>>{1};
+        new (from.data) han::maybe<std::string>{std::string(100, 'x')};
+        han::relocate_at(from.data, to.data);
+        expect(that % to.data->or_else(std::string{}).size() == 100u);
+        std::destroy_at(to.data);
+    };
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <han/result.hh>
+#include <han/testing/lifecycle_counter.hh>
+#include <boost/ut.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace {
+    enum class error_code : std::uint8_t { empty, not_a_digit, too_large };
+
+    struct unknown {};
+
+    constexpr auto parse(std::string_view text) noexcept -> han::result<int, error_code> {
+        if (text.empty()) return han::fail(error_code::empty);
+        auto value = 0;
+        for (auto c : text) {
+            if (c < '0' || c > '9') return han::fail(error_code::not_a_digit);
+            value = value * 10 + (c - '0');
+        }
+        return han::result<int, error_code>{value};
+    }
+
+    constexpr auto at_most_99(int x) noexcept -> han::result<int, error_code> {
+        if (x > 99) return han::fail(error_code::too_large);
+        else return han::result<int, error_code>{x};
+    }
+
+    constexpr auto twice = [](int x) noexcept { return 2 * x; };
+}
+
+static_assert(sizeof(han::result<int, error_code>) == sizeof(int) * 2);
+static_assert(sizeof(han::result<double, unknown>) == sizeof(double));
+static_assert(sizeof(han::result<int*, unknown>) == sizeof(int*));
+static_assert(std::is_trivially_copyable_v<han::result<int, error_code>>);
+static_assert(std::is_nothrow_move_constructible_v<han::result<std::string, std::string>>);
+static_assert(noexcept(parse("1").then_do(twice)));
+static_assert(noexcept(parse("1").then_maybe(at_most_99)));
+
+static_assert(parse("21").then_do(twice).or_else(0) == 42);
+static_assert(parse("x").then_do(twice).or_else(-1) == -1);
+static_assert(parse("120").then_maybe(at_most_99).error() == error_code::too_large);
+static_assert(parse("").then_maybe(at_most_99).error() == error_code::empty);
+static_assert(parse("x").or_maybe([](error_code) { return parse("7"); }).or_else(0) == 7);
+static_assert(parse("x").or_else_do([](error_code e) { return e == error_code::not_a_digit ? 1 : 2; }).or_else(0) == 1);
+static_assert(han::to_result(han::maybe{3}, error_code::empty).or_else(0) == 3);
+static_assert(han::result<double, unknown>{han::fail(unknown{})}.as_maybe() == std::nullopt);
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[construction]"_test = [] {
+        auto ok = han::result<std::string, int>{"value"s};
+        auto bad = han::result<std::string, int>{han::fail(5)};
+        expect(ok.as_maybe() == "value"s);
+        expect(ok.error() == std::nullopt);
+        expect(bad.as_maybe() == std::nullopt);
+        expect(bad.error() == 5);
+        auto built = han::result<std::string, int>{std::in_place, 3u, 'z'};
+        expect(that % built.or_else(""s) == "zzz"s);
+        auto converted = han::result<int, std::string>{han::fail("bad")};
+        expect(converted.error() == "bad"s);
+    };
+
+    "[combinators]"_test = [] {
+        "the error travels down the chain"_test = [] {
+            auto calls = 0;
+            auto r = parse("4x").then_do([&](int x) { ++calls; return x + 1; }).then_maybe(at_most_99);
+            expect(that % calls == 0);
+            expect(r.error() == error_code::not_a_digit);
+        };
+        "values are transformed"_test = [] {
+            expect(parse("12").then_do(twice).then_maybe(at_most_99).then_do(twice).as_maybe() == 48);
+            expect(parse("60").then_do(twice).then_maybe(at_most_99).error() == error_code::too_large);
+        };
+        "side effects return the same result"_test = [] {
+            auto r = parse("5");
+            auto seen = 0;
+            auto& same = r.then_do([&](int x) { seen = x; });
+            expect(&same == &r);
+            expect(that % seen == 5);
+            auto reason = error_code::empty;
+            parse("?").or_else_do([&](error_code e) { reason = e; });
+            expect(reason == error_code::not_a_digit);
+        };
+        "error handlers may ignore the error"_test = [] {
+            expect(that % parse("").or_else_do([] { return 9; }).or_else(0) == 9);
+            expect(that % parse("").or_maybe([] { return parse("8"); }).or_else(0) == 8);
+        };
+        "recovery may change the error type"_test = [] {
+            auto r = parse("x").or_maybe([](error_code e) -> han::result<int, std::string> {
+                if (e == error_code::empty) return han::result<int, std::string>{0};
+                return han::fail("not a number"s);
+            });
+            expect(r.error() == "not a number"s);
+        };
+        "member pointers"_test = [] {
+            auto r = han::result<std::string, int>{"abc"s};
+            expect(r.then_do(&std::string::size).as_maybe() == 3u);
+        };
+    };
+
+    "[conversions]"_test = [] {
+        expect(han::to_result(han::maybe<int>{}, "missing"s).error() == "missing"s);
+        auto text = "kept"s;
+        expect(han::to_result(han::maybe<std::string&>{text}, 0).as_maybe() == "kept"s);
+        expect(that % text == "kept"s);
+        auto owned = han::result<std::unique_ptr<int>, int>{std::make_unique<int>(4)};
+        auto moved = std::move(owned).as_maybe();
+        expect(moved.then_do([](const std::unique_ptr<int>& p) { return *p; }) == 4);
+    };
+
+    "[moves]"_test = [] {
+        "the value moves down an rvalue chain"_test = [] {
+            auto counter = han::testing::lifecycle_counter{};
+            using result = han::result<han::testing::tracked, int>;
+            auto r = result{std::in_place, counter, 'a'};
+            auto tag = std::move(r).then_do([](han::testing::tracked t) { return t.tag(); }).or_else('?');
+            expect(that % tag == 'a');
+            expect(that % counter.copied() == ""s);
+        };
+        "the error moves down an rvalue chain"_test = [] {
+            auto counter = han::testing::lifecycle_counter{};
+            using result = han::result<int, han::testing::tracked>;
+            auto r = result{han::fail(counter.make('e'))};
+            auto error = std::move(r).then_do(twice).then_maybe([](int x) { return result{x}; }).error();
+            expect(that % counter.copied() == ""s);
+            expect(error.then_do([](const han::testing::tracked& t) { return t.tag(); }) == 'e');
+        };
+        "a void callable taking a copy leaves the value in place"_test = [] {
+            using result = han::result<std::string, error_code>;
+            auto text = std::string(40, 'x');
+            auto seen = std::string{};
+            auto kept = result{text}.then_do([&](std::string s) { seen = std::move(s); }).then_do([](std::string s) { return s; });
+            expect(seen == text);
+            expect(kept.as_maybe() == text);
+        };
+    };
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <han/serialize.hh>
+#include <boost/ut.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+    enum class tier : std::uint8_t { free, paid };
+
+    struct address {
+        han::maybe<std::string> street;
+        std::string city;
+        han::maybe<std::int32_t> zip;
+    };
+
+    struct customer {
+        std::uint64_t id = 0;
+        han::maybe<std::string> name;
+        han::maybe<address> home;
+        han::maybe<han::maybe<double>> score;
+        han::maybe<tier> plan;
+        std::vector<han::maybe<int>> visits;
+    };
+
+    struct point {
+        han::maybe<std::int16_t> x;
+        han::maybe<std::int16_t> y;
+    };
+
+    struct token {
+        han::maybe<std::string_view> text;
+    };
+
+    auto operator==(const address& a, const address& b) -> bool {
+        return a.street == b.street && a.city == b.city && a.zip == b.zip;
+    }
+
+    auto operator==(const customer& a, const customer& b) -> bool {
+        return a.id == b.id && a.name == b.name && a.home == b.home && a.score == b.score && a.plan == b.plan &&
+               a.visits == b.visits;
+    }
+
+    template <typename T>
+    auto round_trip(const T& value) -> T {
+        auto bytes = han::serialize(value);
+        auto out = T{};
+        auto used = han::deserialize(bytes.data(), bytes.size(), out);
+        boost::ut::expect(used == bytes.size());
+        return out;
+    }
+
+    template <typename T>
+    auto encoded(const T& value) -> std::vector<unsigned> {
+        auto out = std::vector<unsigned>{};
+        for (auto b : han::serialize(value)) out.push_back(std::to_integer<unsigned>(b));
+        return out;
+    }
+}
+
+template <>
+struct han::serial_traits<address> {
+    template <typename R>
+    constexpr static auto tie(R& r) noexcept { return std::tie(r.street, r.city, r.zip); }
+};
+
+template <>
+struct han::serial_traits<customer> {
+    template <typename R>
+    constexpr static auto tie(R& r) noexcept { return std::tie(r.id, r.name, r.home, r.score, r.plan, r.visits); }
+};
+
+template <>
+struct han::serial_traits<point> {
+    template <typename R>
+    constexpr static auto tie(R& r) noexcept { return std::tie(r.x, r.y); }
+};
+
+template <>
+struct han::serial_traits<token> {
+    template <typename R>
+    constexpr static auto tie(R& r) noexcept { return std::tie(r.text); }
+};
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[layout]"_test = [] {
+        "absent payloads are skipped"_test = [] {
+            auto x = han::maybe<std::int16_t>{std::int16_t{0x0102}};
+            expect(encoded(point{x, {}}) == std::vector<unsigned>{0x01, 0x02, 0x01});
+            expect(encoded(point{{}, x}) == std::vector<unsigned>{0x02, 0x02, 0x01});
+            expect(encoded(point{}) == std::vector<unsigned>{0x00});
+        };
+        "sequences share one bitmap"_test = [] {
+            auto v = std::vector<han::maybe<std::uint8_t>>(9);
+            v[0] = han::maybe{std::uint8_t{7}};
+            v[8] = han::maybe{std::uint8_t{9}};
+            expect(encoded(v) == std::vector<unsigned>{9, 0x01, 0x01, 7, 9});
+        };
+        "nested maybes take one bit per level"_test = [] {
+            using nested = han::maybe<han::maybe<std::uint8_t>>;
+            expect(encoded(nested{}) == std::vector<unsigned>{0x00});
+            expect(encoded(nested{han::maybe<std::uint8_t>{}}) == std::vector<unsigned>{0x01});
+            expect(encoded(nested{han::maybe{std::uint8_t{5}}}) == std::vector<unsigned>{0x03, 5});
+        };
+    };
+
+    "[round trip]"_test = [] {
+        "records"_test = [] {
+            auto full = customer{42, han::maybe{"ada"s},
+                                 han::maybe{address{han::maybe{"main st"s}, "paris"s, han::maybe{75001}}},
+                                 han::maybe<han::maybe<double>>{han::maybe{0.5}}, han::maybe{tier::paid},
+                                 {han::maybe{1}, std::nullopt, han::maybe{3}}};
+            expect(round_trip(full) == full);
+            auto partial = customer{7, {}, han::maybe{address{{}, "oslo"s, {}}},
+                                    han::maybe<han::maybe<double>>{han::maybe<double>{}}, {}, {}};
+            expect(round_trip(partial) == partial);
+            expect(round_trip(customer{}) == customer{});
+        };
+        "top level maybes"_test = [] {
+            expect(round_trip(han::maybe{"x"s}) == han::maybe{"x"s});
+            expect(round_trip(han::maybe<int>{}) == std::nullopt);
+        };
+    };
+
+    "[reading]"_test = [] {
+        "existing buffers are reused"_test = [] {
+            auto source = customer{1, han::maybe{"short"s}, {}, {}, {}, {}};
+            auto wire = han::serialize(source);
+            auto target = customer{};
+            target.name = han::maybe{std::string(64, 'x')};
+            auto data = [](const std::string& s) { return s.data(); };
+            auto before = target.name.then_do(data).or_else(nullptr);
+            expect(han::deserialize(wire.data(), wire.size(), target) == wire.size());
+            expect(target.name == "short"sv);
+            expect(target.name.then_do(data).or_else(nullptr) == before);
+        };
+        "string views point into the input"_test = [] {
+            auto wire = han::serialize(token{han::maybe{"word"sv}});
+            auto out = token{};
+            expect(han::deserialize(wire.data(), wire.size(), out) == wire.size());
+            expect(out.text == "word"sv);
+            auto at = out.text.then_do([](std::string_view s) { return reinterpret_cast<const std::byte*>(s.data()); });
+            expect(at.or_else(nullptr) == wire.data() + 2);
+        };
+        "absent fields clear the target"_test = [] {
+            auto wire = han::serialize(customer{});
+            auto target = customer{9, han::maybe{"old"s}, {}, han::maybe<han::maybe<double>>{han::maybe{1.0}},
+                                   han::maybe{tier::free}, {han::maybe{1}}};
+            expect(han::deserialize(wire.data(), wire.size(), target) == wire.size());
+            expect(target == customer{});
+        };
+        "truncated input is rejected"_test = [] {
+            auto full = customer{42, han::maybe{"ada"s},
+                                 han::maybe{address{han::maybe{"main st"s}, "paris"s, han::maybe{75001}}},
+                                 han::maybe<han::maybe<double>>{han::maybe{0.5}}, han::maybe{tier::paid},
+                                 {han::maybe{1}, std::nullopt}};
+            auto wire = han::serialize(full);
+            for (auto size = std::size_t{0}; size < wire.size(); ++size) {
+                auto out = customer{};
+                expect(han::deserialize(wire.data(), size, out) == std::nullopt) << "prefix of" << size << "bytes";
+            }
+        };
+    };
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <han/maybe_vector.hh>
+#include <boost/ut.hpp>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+    // Bytes handed out by operator new, so memory use is measured from the
+    // outside rather than from the container's own bookkeeping.
+    std::size_t allocated = 0;
+}
+
+[[gnu::noinline]] auto operator new(std::size_t size) -> void* {
+    allocated += size;
+    if (auto* p = std::malloc(size == 0 ? 1 : size)) return p;
+#if defined(__cpp_exceptions)
+    throw std::bad_alloc{};
+#else
+    std::abort();
+#endif
+}
+
+[[gnu::noinline]] auto operator delete(void* p) noexcept -> void { std::free(p); }
+[[gnu::noinline]] auto operator delete(void* p, std::size_t) noexcept -> void { std::free(p); }
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[maybe_vector::push_back()]"_test = [] {
+        auto v = han::maybe_vector<int>{};
+        v.push_back(1);
+        v.push_back(std::nullopt);
+        v.push_back(han::maybe{3});
+        v.push_back(han::maybe<int>{});
+        expect(that % v.size() == 4u);
+        expect(that % v.count() == 2u);
+        expect(that % v[0].or_else(0) == 1);
+        expect(that % v[1].or_else(0) == 0);
+        expect(that % v[2].or_else(0) == 3);
+        expect(that % v[3].or_else(0) == 0);
+    };
+
+    "[maybe_vector::emplace_back()]"_test = [] {
+        auto v = han::maybe_vector<std::string>{};
+        expect(that % v.emplace_back(3u, 'x') == "xxx"s);
+        expect(that % v.get(0).or_else(""s) == "xxx"s);
+    };
+
+    "[maybe_vector crosses bitmap words]"_test = [] {
+        auto v = han::maybe_vector<int>{};
+        v.reserve(200);
+        for (auto i = 0; i < 200; ++i) {
+            if (i % 3 == 0) v.push_back(i);
+            else v.push_back(std::nullopt);
+        }
+        expect(that % v.count() == 67u);
+        auto ok = true;
+        for (auto i = 0; i < 200; ++i) {
+            ok = ok && v[static_cast<std::size_t>(i)].or_else(-1) == (i % 3 == 0 ? i : -1);
+        }
+        expect(ok);
+    };
+
+    "[maybe_vector element access is a reference]"_test = [] {
+        auto v = han::maybe_vector<std::string>{han::maybe{"a"s}, std::nullopt};
+        v[0].then_do([](std::string& x) { x += "b"; });
+        v[1].then_do([](std::string& x) { x += "b"; });
+        expect(that % v[0].or_else(""s) == "ab"s);
+        expect(that % v[1].or_else(""s) == ""s);
+    };
+
+    "[maybe_vector::set() and reset()]"_test = [] {
+        auto v = han::maybe_vector<int>{std::nullopt, han::maybe{2}};
+        v.set(0, 1);
+        v.reset(1);
+        expect(that % v[0].or_else(0) == 1);
+        expect(that % v[1].or_else(0) == 0);
+        expect(that % v.count() == 1u);
+    };
+
+    "[maybe_vector iteration]"_test = [] {
+        auto v = han::maybe_vector<int>{han::maybe{1}, std::nullopt, han::maybe{3}};
+        auto sum = 0;
+        auto missing = 0;
+        for (auto x : v) x.then_do([&](int y) { sum += y; }).or_else_do([&] { ++missing; });
+        expect(that % sum == 4);
+        expect(that % missing == 1);
+        for (auto x : v) x.then_do([](int& y) { y *= 10; });
+        const auto& c = v;
+        sum = 0;
+        for (auto x : c) x.then_do([&](const int& y) { sum += y; });
+        expect(that % sum == 40);
+    };
+
+    "[maybe_vector memory per element]"_test = [] {
+        // 65536 doubles take 524288 bytes, and their presence bits 1024
+        // words of 8 bytes.
+        constexpr auto count = std::size_t{1} << 16;
+        auto before = allocated;
+        auto v = han::maybe_vector<double>{};
+        v.reserve(count);
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            if (i % 3 == 0) v.push_back(std::nullopt);
+            else v.push_back(static_cast<double>(i));
+        }
+        expect(that % (allocated - before) <= std::size_t{524288 + 8192});
+    };
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <han/views.hh>
+#include <han/maybe_vector.hh>
+#include <boost/ut.hpp>
+#include <list>
+#include <string>
+#include <vector>
+
+template <typename R>
+auto collect(R&& range) {
+    auto out = std::vector<std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(range))>>>{};
+    for (auto&& x : range) out.push_back(x);
+    return out;
+}
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[maybe is a range of zero or one elements]"_test = [] {
+        auto sum = 0;
+        for (auto x : han::maybe{5}) sum += x;
+        for (auto x : han::maybe<int>{}) sum += x;
+        expect(that % sum == 5);
+        auto name = han::maybe{"a"s};
+        for (auto& x : name) x += "b";
+        expect(that % name.or_else(""s) == "ab"s);
+        auto y = 1;
+        for (auto& x : han::maybe<int&>{y}) ++x;
+        expect(that % y == 2);
+    };
+
+    "[views::present]"_test = [] {
+        auto v = std::vector<han::maybe<int>>{han::maybe{1}, std::nullopt, han::maybe{3}, std::nullopt};
+        expect(collect(v | han::views::present) == std::vector<int>{1, 3});
+        expect(collect(han::views::present(std::vector<han::maybe<int>>{})).empty());
+        for (auto& x : v | han::views::present) x *= 10;
+        expect(that % v[2].or_else(0) == 30);
+
+        auto l = std::list<han::maybe<std::string>>{std::nullopt, han::maybe{"x"s}};
+        expect(collect(l | han::views::present) == std::vector<std::string>{"x"s});
+
+        auto column = han::maybe_vector<int>{han::maybe{1}, std::nullopt, han::maybe{2}};
+        expect(collect(column | han::views::present) == std::vector<int>{1, 2});
+    };
+
+    "[views::transform_maybe]"_test = [] {
+        auto v = std::vector<han::maybe<int>>{han::maybe{1}, std::nullopt, han::maybe{3}};
+        auto calls = 0;
+        auto doubled = v | han::views::transform_maybe([&](int x) { ++calls; return x * 2; });
+        expect(that % calls == 0);
+        auto out = collect(doubled);
+        expect(that % out.size() == 3u);
+        expect(that % out[0].or_else(0) == 2);
+        expect(that % out[1].or_else(0) == 0);
+        expect(that % out[2].or_else(0) == 6);
+        expect(that % calls == 2);
+        auto strings = han::views::transform_maybe(v, [](int x) { return std::to_string(x); });
+        expect(collect(strings | han::views::present) == std::vector<std::string>{"1"s, "3"s});
+    };
+
+    "[views::present runs a computed element once]"_test = [] {
+        auto v = std::vector<han::maybe<int>>{han::maybe{1}, std::nullopt, han::maybe{3}, han::maybe{4}};
+        auto calls = 0;
+        auto doubled = v | han::views::transform_maybe([&](int x) { ++calls; return x * 2; }) | han::views::present;
+        auto sum = 0;
+        for (auto it = doubled.begin(); it != doubled.end(); ++it) sum += *it + *it;
+        expect(that % sum == 32);
+        expect(that % calls == 3);
+    };
+
+    "[views::flatten]"_test = [] {
+        auto v = std::vector<han::maybe<int>>{std::nullopt, han::maybe{1}, std::nullopt, han::maybe{3}};
+        expect(collect(v | han::views::flatten) == std::vector<int>{1, 3});
+        auto nested = std::vector<std::vector<int>>{{}, {1, 2}, {}, {3}};
+        expect(collect(nested | han::views::flatten) == std::vector<int>{1, 2, 3});
+        auto column = han::maybe_vector<int>{std::nullopt, han::maybe{4}, han::maybe{5}};
+        expect(collect(column | han::views::flatten) == std::vector<int>{4, 5});
+    };
+
+#if defined(__cpp_lib_ranges)
+    "[C++20 ranges]"_test = [] {
+        auto v = std::vector<han::maybe<int>>{han::maybe{1}, std::nullopt, han::maybe{3}, han::maybe{4}};
+        auto present = v | han::views::present;
+        static_assert(std::ranges::forward_range<decltype(present)>);
+        static_assert(std::ranges::view<decltype(present)>);
+        static_assert(std::ranges::contiguous_range<han::maybe<int>>);
+        static_assert(std::ranges::borrowed_range<han::maybe<int&>>);
+        auto taken = v | han::views::present | std::views::take(2);
+        expect(collect(taken) == std::vector<int>{1, 3});
+        auto odd = v | std::views::filter([](const han::maybe<int>& m) { return m.then_do([](int x) { return x % 2; }).or_else(1) == 1; });
+        expect(collect(odd | han::views::present) == std::vector<int>{1, 3});
+    };
+#endif
+
+    return 0;
+}
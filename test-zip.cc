@@ -0,0 +1,92 @@
+#include <han/zip.hh>
+#include <han/testing/lifecycle_counter.hh>
+#include <boost/ut.hpp>
+#include <string>
+#include <utility>
+
+static_assert(std::is_same_v<decltype(han::zip(han::maybe{1}, han::maybe{2.0})),
+                             han::maybe<std::tuple<int, double>>>);
+static_assert(std::is_same_v<decltype(han::zip(std::declval<han::maybe<int&>>(), han::maybe{2})),
+                             han::maybe<std::tuple<int&, int>>>);
+static_assert(noexcept(han::zip(han::maybe{1}, han::maybe{2})));
+static_assert(!noexcept(han::zip(std::declval<const han::maybe<std::string>&>())));
+
+auto main() -> int {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "[zip()]"_test = [] {
+        "all present"_test = [] {
+            auto both = han::zip(han::maybe{1}, han::maybe{"one"s});
+            expect(both.then_do([](const auto& t) { return std::get<0>(t) == 1 && std::get<1>(t) == "one"s; })
+                       .or_else(false));
+        };
+        "one missing"_test = [] {
+            auto name = han::maybe{"one"s};
+            expect(!han::zip(han::maybe{1}, han::maybe<double>{}, name).then_do([](auto&&) { return true; })
+                        .or_else(false));
+        };
+        "references stay references"_test = [] {
+            auto x = 1;
+            han::zip(han::maybe<int&>{x}, han::maybe{41}).then_do([](auto&& t) { std::get<0>(t) += std::get<1>(t); });
+            expect(that % x == 42);
+        };
+    };
+
+    "[apply()]"_test = [] {
+        "all present"_test = [] {
+            auto sum = han::apply([](int a, int b, int c) { return a + b + c; }, han::maybe{1}, han::maybe{2}, han::maybe{3});
+            expect(that % sum.or_else(0) == 6);
+        };
+        "one missing"_test = [] {
+            auto calls = 0;
+            auto sum = han::apply([&](int a, int b) { ++calls; return a + b; }, han::maybe{1}, han::maybe<int>{});
+            expect(that % sum.or_else(0) == 0);
+            expect(that % calls == 0);
+        };
+        "void callables report whether they ran"_test = [] {
+            auto seen = 0;
+            expect(han::apply([&](int a, int b) { seen = a * b; }, han::maybe{6}, han::maybe{7}));
+            expect(!han::apply([&](int a, int b) { seen = a + b; }, han::maybe{6}, han::maybe<int>{}));
+            expect(that % seen == 42);
+        };
+        "results are wrapped like then_do()"_test = [] {
+            auto pair = std::pair{1, "b"s};
+            auto first = han::apply([&](int) -> int& { return pair.first; }, han::maybe{0});
+            static_assert(std::is_same_v<decltype(first), han::maybe<int&>>);
+            first.then_do([](int& x) { x = 5; });
+            expect(that % pair.first == 5);
+            auto second = han::apply([&](int) -> std::string&& { return std::move(pair.second); }, han::maybe{0});
+            static_assert(std::is_same_v<decltype(second), han::maybe<std::string>>);
+            expect(second == "b"s);
+            auto half = han::apply([](int a, int b) { return a % b == 0 ? han::maybe{a / b} : han::maybe<int>{}; },
+                                   han::maybe{7}, han::maybe{2});
+            static_assert(std::is_same_v<decltype(half), han::maybe<int>>);
+            expect(half == std::nullopt);
+        };
+    };
+
+    "[copies in zip() and apply()]"_test = [] {
+        "rvalues are moved once, lvalues copied once"_test = [] {
+            auto counter = han::testing::lifecycle_counter{};
+            auto a = han::make_maybe<han::testing::tracked>(counter, 'a');
+            auto b = han::make_maybe<han::testing::tracked>(counter, 'b');
+            auto zipped = han::zip(a, std::move(b));
+            expect(that % counter.copied() == "a"s);
+            expect(that % counter.moved() == "b"s);
+        };
+        "apply() forwards without copies"_test = [] {
+            auto counter = han::testing::lifecycle_counter{};
+            auto a = han::make_maybe<han::testing::tracked>(counter, 'a');
+            auto b = han::make_maybe<han::testing::tracked>(counter, 'b');
+            auto tags = han::apply([](const han::testing::tracked& x, han::testing::tracked y) {
+                return std::string{x.tag(), y.tag()};
+            }, a, std::move(b));
+            expect(that % tags.or_else(""s) == "ab"s);
+            expect(that % counter.copied() == ""s);
+            expect(that % counter.moved() == "b"s);
+        };
+    };
+
+    return 0;
+}
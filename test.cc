@@ -1,5 +1,107 @@
 #include <han/maybe.hh>
 #include <boost/ut.hpp>
+#include <cmath>
+#include <map>
+#include <string>
+#include <string_view>
+
+enum class color : unsigned char { red, green, blue, none };
+
+template <>
+struct han::niche_traits<color> : han::niche_value<color, color::none> {};
+
+struct user_id {
+    int value;
+};
+
+template <>
+struct han::niche_traits<user_id> {
+    constexpr static auto empty() noexcept -> user_id { return {-1}; }
+    constexpr static auto is_empty(const user_id& id) noexcept -> bool { return id.value < 0; }
+};
+
+static_assert(sizeof(han::maybe<int*>) == sizeof(int*));
+static_assert(sizeof(han::maybe<const char*>) == sizeof(const char*));
+static_assert(sizeof(han::maybe<double>) == sizeof(double));
+static_assert(sizeof(han::maybe<float>) == sizeof(float));
+static_assert(sizeof(han::maybe<std::string_view>) == sizeof(std::string_view));
+static_assert(sizeof(han::maybe<std::wstring_view>) == sizeof(std::wstring_view));
+static_assert(sizeof(han::maybe<color>) == sizeof(color));
+static_assert(sizeof(han::maybe<user_id>) == sizeof(user_id));
+static_assert(sizeof(han::maybe<int>) == sizeof(std::optional<int>));
+static_assert(sizeof(han::maybe<long>) == sizeof(std::optional<long>));
+
+static_assert(std::is_trivially_copyable_v<han::maybe<int*>>);
+static_assert(std::is_trivially_copyable_v<han::maybe<double>>);
+static_assert(std::is_trivially_copyable_v<han::maybe<std::string_view>>);
+
+static_assert(sizeof(han::maybe<std::string&>) == sizeof(std::string*));
+static_assert(sizeof(han::maybe<const std::string&>) == sizeof(std::string*));
+static_assert(std::is_trivially_copyable_v<han::maybe<std::string&>>);
+static_assert(std::is_trivially_copyable_v<han::maybe<const std::string&>>);
+static_assert(std::is_convertible_v<han::maybe<int&>, han::maybe<const int&>>);
+static_assert(!std::is_convertible_v<han::maybe<const int&>, han::maybe<int&>>);
+static_assert(!std::is_constructible_v<han::maybe<const int&>, int&&>);
+
+static_assert(std::is_nothrow_move_assignable_v<han::maybe<std::string>>);
+static_assert(!std::is_nothrow_copy_assignable_v<han::maybe<std::string>>);
+static_assert(std::is_nothrow_swappable_v<han::maybe<std::string>>);
+static_assert(std::is_nothrow_swappable_v<han::maybe<double>>);
+static_assert(std::is_nothrow_swappable_v<han::maybe<int&>>);
+
+static_assert(std::is_nothrow_move_constructible_v<han::maybe<std::string>>);
+static_assert(!std::is_nothrow_copy_constructible_v<han::maybe<std::string>>);
+static_assert(std::is_nothrow_copy_constructible_v<han::maybe<int>>);
+static_assert(std::is_nothrow_constructible_v<han::maybe<int>, std::in_place_t, int>);
+static_assert(!std::is_nothrow_constructible_v<han::maybe<std::string>, std::in_place_t, const char*>);
+static_assert(noexcept(han::make_maybe<int>(1)));
+static_assert(noexcept(std::declval<han::maybe<int>&>().emplace(1)));
+static_assert(noexcept(std::declval<han::maybe<double>&>().emplace(1.0)));
+
+constexpr auto nothrow_step = [](int x) noexcept { return x + 1; };
+constexpr auto throwing_step = [](int x) { return x + 1; };
+constexpr auto nothrow_check = [](int) noexcept {};
+constexpr auto nothrow_fallback = []() noexcept { return 0; };
+constexpr auto nothrow_nested = [](int x) noexcept { return han::maybe{x}; };
+constexpr auto nothrow_alternative = []() noexcept { return han::maybe{0}; };
+constexpr auto nothrow_string = []() noexcept { return std::string{}; };
+constexpr auto by_value = [](std::string) noexcept {};
+constexpr auto by_ref = [](const std::string&) noexcept {};
+
+static_assert(noexcept(han::maybe<int>{}.or_else(0)));
+static_assert(noexcept(std::declval<const han::maybe<int>&>().then_do(nothrow_step)));
+static_assert(noexcept(han::maybe<int>{}.then_do(nothrow_step)));
+static_assert(!noexcept(han::maybe<int>{}.then_do(throwing_step)));
+static_assert(noexcept(han::maybe<int>{}.then_do(nothrow_check)));
+static_assert(noexcept(han::maybe<int>{}.or_else_do(nothrow_fallback)));
+static_assert(noexcept(han::maybe<int>{}.then_maybe(nothrow_nested)));
+static_assert(noexcept(han::maybe<int>{}.or_maybe(nothrow_alternative)));
+static_assert(noexcept(han::maybe<std::string>{}.then_do(by_ref)));
+static_assert(!noexcept(han::maybe<std::string>{}.then_do(by_value)));
+static_assert(!noexcept(std::declval<const han::maybe<std::string>&>().or_else_do(nothrow_string)));
+static_assert(noexcept(han::maybe<std::string>{}.or_else_do(nothrow_string)));
+static_assert(noexcept(han::maybe<std::string>{}.or_else(std::string{})));
+static_assert(noexcept(std::declval<han::maybe<int&>>().then_do(nothrow_step)));
+static_assert(!noexcept(std::declval<han::maybe<int&>>().then_do(throwing_step)));
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+template <typename M, typename C>
+constexpr bool can_then_do = requires(M m, C code) { std::move(m).then_do(code); };
+
+constexpr auto moved_in = [](std::string&&) {};
+constexpr auto step_moved_in = [](std::string&& s) { return s.size(); };
+
+static_assert(!can_then_do<han::maybe<std::string>, decltype(moved_in)>);
+static_assert(can_then_do<han::maybe<std::string>, decltype(step_moved_in)>);
+static_assert(can_then_do<han::maybe<std::string>, decltype(by_value)>);
+static_assert(can_then_do<han::maybe<std::string>, void (*)(std::string&)>);
+#endif
+
+template <typename K, typename V>
+auto lookup(std::map<K, V>& map, const K& key) -> han::maybe<V&> {
+    if (auto it = map.find(key); it != map.end()) return han::maybe<V&>{it->second};
+    else return std::nullopt;
+}
 
 template <typename T>
 auto helper(bool present, T&& value) -> han::maybe<T> {
@@ -58,6 +160,14 @@ auto main() -> int {
             expect(!run);
             expect(that % value.or_else(10) == 10);
         };
+
+        "a by-value callable sees a copy and the value is kept"_test = [] {
+            auto seen = std::string{};
+            auto text = std::string(40, 'x');
+            auto value = han::maybe{text}.then_do([&](std::string s) { seen = std::move(s); });
+            expect(seen == text);
+            expect(value.or_else(""s) == text);
+        };
     };
 
     "[maybe::or_else_do()]"_test = [] {
@@ -141,5 +251,121 @@ auto main() -> int {
         };
     };
 
+    "[maybe with niche storage]"_test = [] {
+        "null pointer is missing"_test = [] {
+            int x = 5;
+            expect(that % han::maybe<int*>{&x}.then_do([](int* p) { return *p; }).or_else(10) == 5);
+            expect(that % han::maybe<int*>{nullptr}.then_do([](int* p) { return *p; }).or_else(10) == 10);
+            expect(that % han::maybe<int*>{}.then_do([](int* p) { return *p; }).or_else(10) == 10);
+        };
+        "ordinary NaN is present"_test = [] {
+            auto value = han::maybe{std::nan("")}.then_do([](double x) { return std::isnan(x); });
+            expect(value.or_else(false));
+            expect(han::maybe<double>{}.or_else(1.5) == 1.5_d);
+            expect(han::maybe<float>{}.or_else(2.5f) == 2.5_f);
+        };
+        "empty string_view is present"_test = [] {
+            expect(that % han::maybe{""sv}.or_else("missing"sv) == ""sv);
+            expect(that % han::maybe<std::string_view>{}.or_else("missing"sv) == "missing"sv);
+        };
+        "reserved enum value"_test = [] {
+            expect(han::maybe{color::red}.or_else(color::blue) == color::red);
+            expect(han::maybe<color>{}.or_else(color::blue) == color::blue);
+            expect(han::maybe{color::none}.or_else(color::blue) == color::blue);
+        };
+        "user-declared invalid id"_test = [] {
+            auto id = [](const user_id& x) { return x.value; };
+            expect(that % han::maybe{user_id{7}}.then_do(id).or_else(0) == 7);
+            expect(that % han::maybe{user_id{-1}}.then_do(id).or_else(0) == 0);
+            expect(that % han::maybe<user_id>{std::nullopt}.then_do(id).or_else(0) == 0);
+        };
+    };
+
+    "[maybe::swap() and maybe::reset()]"_test = [] {
+        "swap() exchanges presence"_test = [] {
+            auto a = han::maybe{"a"s};
+            auto b = han::maybe<std::string>{};
+            a.swap(b);
+            expect(that % a.or_else("none"s) == "none"s);
+            expect(that % b.or_else("none"s) == "a"s);
+            swap(a, b);
+            expect(that % a.or_else("none"s) == "a"s);
+            expect(that % b.or_else("none"s) == "none"s);
+        };
+        "swap() with niche storage"_test = [] {
+            auto a = han::maybe{1.5};
+            auto b = han::maybe<double>{};
+            using std::swap;
+            swap(a, b);
+            expect(a.or_else(0.0) == 0.0_d);
+            expect(b.or_else(0.0) == 1.5_d);
+        };
+        "reset() empties the value"_test = [] {
+            auto a = han::maybe{"a"s};
+            auto b = han::maybe{color::red};
+            a.reset();
+            b.reset();
+            expect(that % a.or_else("none"s) == "none"s);
+            expect(b.or_else(color::blue) == color::blue);
+        };
+        "maybe<T&> swaps and resets the reference"_test = [] {
+            auto x = 1;
+            auto y = 2;
+            auto a = han::maybe<int&>{x};
+            auto b = han::maybe<int&>{y};
+            swap(a, b);
+            expect(&a.or_else(x) == &y);
+            a.reset();
+            expect(&a.or_else(x) == &x);
+            expect(that % y == 2);
+        };
+    };
+
+    "[maybe<T&>]"_test = [] {
+        auto map = std::map<int, std::string>{{1, "one"}, {2, "two"}};
+
+        "or_else() refers to the element"_test = [&] {
+            auto alt = "none"s;
+            expect(&lookup(map, 1).or_else(alt) == &map[1]);
+            expect(&lookup(map, 3).or_else(alt) == &alt);
+        };
+        "or_else() of a temporary returns a value"_test = [&] {
+            expect(that % lookup(map, 1).or_else("none"s) == "one"s);
+            expect(that % lookup(map, 3).or_else("none"s) == "none"s);
+        };
+        "then_do() modifies the element in place"_test = [&] {
+            lookup(map, 2).then_do([](std::string& x) { x += "!"; });
+            expect(that % map[2] == "two!"s);
+        };
+        "then_do() may return another reference"_test = [&] {
+            auto first = lookup(map, 1).then_do([](std::string& x) -> char& { return x.front(); });
+            static_assert(std::is_same_v<decltype(first), han::maybe<char&>>);
+            auto none = 'x';
+            expect(&first.or_else(none) == map[1].data());
+        };
+        "then_maybe() and or_maybe()"_test = [&] {
+            auto other = "other"s;
+            auto value = lookup(map, 3)
+                .or_maybe([&] { return lookup(map, 1); })
+                .then_maybe([&](const std::string& x) { return han::maybe<const std::string&>{x}; });
+            expect(&value.or_else(other) == &map[1]);
+            auto missing = lookup(map, 3).then_maybe([&](std::string& x) { return han::maybe<std::string&>{x}; });
+            expect(&missing.or_else(other) == &other);
+        };
+        "or_else_do()"_test = [&] {
+            auto other = "other"s;
+            bool run = false;
+            auto value = lookup(map, 3).or_else_do([&] { run = true; });
+            expect(run);
+            auto fallback = value.or_else_do([&]() -> std::string& { return other; });
+            expect(&fallback.or_else(map[1]) == &other);
+        };
+        "maybe<const T&> from maybe<T&>"_test = [&] {
+            auto other = "other"s;
+            han::maybe<const std::string&> value = lookup(map, 1);
+            expect(&value.or_else(other) == &map[1]);
+        };
+    };
+
     return 0;
 }